@@ -17,7 +17,7 @@ namespace droid::audio {
     class AudioCmdHandler : public droid::command::CmdHandler {
     public:
         AudioCmdHandler(const char* name, droid::core::System* system, AudioMgr* audioMgr);
-        bool process(const char* device, const char* command);
+        bool execute(const char* command) override;
 
     private:
         AudioMgr* audioMgr = nullptr;
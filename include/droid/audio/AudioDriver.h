@@ -52,7 +52,9 @@ namespace droid::audio {
     class AudioDriver : public droid::core::BaseComponent {
     public:
         AudioDriver(const char* name, droid::core::System* system) :
-            BaseComponent(name, system) {}
+            BaseComponent(name, system) {
+            setSchedule(SCHEDULE_HOUSEKEEPING_PERIOD_US, 0, SCHEDULE_PRIORITY_HOUSEKEEPING);
+        }
             
         //Virtual methods required by BaseComponent declared here as NOOPs for concrete sub-classes
         void init() {}
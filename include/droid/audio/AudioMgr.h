@@ -17,6 +17,7 @@ namespace droid::audio {
     class AudioMgr : public droid::core::BaseComponent {
     public:
         AudioMgr(const char* name, droid::core::System* system, AudioDriver* driver);
+        static constexpr uint8_t TIMER_COUNT = 1;     //Random sound deadline
 
         //Override virtual methods from BaseComponent
         void init() override;
@@ -24,6 +25,7 @@ namespace droid::audio {
         void task() override;
         void logConfig() override;
         void failsafe() override;
+        void timerExpired(droid::core::TimerId timer) override;
 
         void setMaxVolume(float maxVolume);
         float getMaxVolume();
@@ -48,13 +50,12 @@ namespace droid::audio {
         float minVolume = 0;
         float volume = 0;
         bool randomPlayEnabled = false;
-        uint32_t nextRandomTime = 0;
+        droid::core::TimerId randomTimer = TIMER_NONE;
         uint32_t lastScheduledCmd = 0;
         int minRandomMilliSeconds = 0;
         int maxRandomMilliSeconds = 0;
         int cmdStaggerMs = 0;
 
         void queueCommand(const char* command, unsigned long delayMs = 0);
-        void randomPlay();
     };
 }
\ No newline at end of file
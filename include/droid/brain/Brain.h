@@ -10,8 +10,10 @@
 
 #pragma once
 #include "droid/core/BaseComponent.h"
+#include "droid/core/Scheduler.h"
 #include "droid/brain/DomeMgr.h"
 #include "droid/brain/DriveMgr.h"
+#include "droid/brain/ControlLoop.h"
 #include "droid/command/ActionMgr.h"
 #include "droid/audio/AudioMgr.h"
 #include "droid/services/PWMService.h"
@@ -31,13 +33,18 @@ namespace droid::brain {
         void logConfig() override;
         void failsafe() override;
         
+        //Starts the control task, call once the Logger is deferred
+        void start();
         void reboot();
         void overrideCmdMap(const char* action, const char* cmd);
         void fireAction(const char* action);
+        void printStats(Print* out);
+        void resetStats();
 
     private:
         droid::brain::DomeMgr* domeMgr;
         droid::brain::DriveMgr* driveMgr;
+        droid::brain::ControlLoop* controlLoop;
         droid::command::ActionMgr* actionMgr;
         droid::audio::AudioMgr* audioMgr;
 
@@ -48,10 +55,14 @@ namespace droid::brain {
         droid::audio::AudioDriver* audioDriver;
 
         std::vector<droid::core::BaseComponent*> componentList;
+        droid::core::Scheduler scheduler;
+        droid::core::TaskStats loopStats;
+        unsigned long statsSince = 0;
 
         char inputBuf[100] = {0};
         uint8_t bufIndex = 0;
 
         void processConsoleInput(Stream* cmdStream);
+        void printStatsLine(Print* out, const char* label, uint32_t period, uint8_t priority, const droid::core::TaskStats& stats, uint32_t overruns);
     };
 }
\ No newline at end of file
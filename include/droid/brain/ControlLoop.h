@@ -0,0 +1,65 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <atomic>
+#include "droid/core/Scheduler.h"
+#include "droid/core/Snapshot.h"
+#include "droid/controller/SnapshotController.h"
+
+namespace droid::brain {
+    /**
+     * @brief Fixed-period control loop for the latency sensitive components
+     * (controller sampling, DriveMgr/DomeMgr and the motor drivers).
+     * Runs on its own FreeRTOS task pinned to one core so that console, audio,
+     * logging and persistence on the main loop cannot delay motor updates.
+     * Controller input is published through a lock-free Snapshot after every
+     * tick; the SnapshotController gives other components read access to it.
+     * When the System Clock is not real time the task is not started and the
+     * ticks are driven from poll() on the main loop instead.
+     */
+    class ControlLoop {
+    public:
+        ControlLoop(const char* name, droid::core::System* system, droid::controller::Controller* controller, uint32_t periodMs);
+
+        void add(droid::core::BaseComponent* component);
+        bool start(uint8_t core, uint8_t priority, uint32_t stackSize);
+        void poll();
+        void requestFailsafe();
+
+        droid::controller::Controller* getSnapshotController() {return snapshotController;}
+        const droid::core::Scheduler& getScheduler() const {return scheduler;}
+        const droid::core::TaskStats& getTickStats() const {return tickStats;}
+        const droid::core::TaskStats& getJitterStats() const {return jitterStats;}
+        void resetStats();
+
+        const char* name;
+
+    private:
+        Logger* logger = nullptr;
+        Clock* clock = nullptr;
+        droid::controller::Controller* controller = nullptr;
+        droid::controller::SnapshotController* snapshotController = nullptr;
+        droid::core::Snapshot<droid::controller::InputSnapshot> snapshot;
+        droid::core::Scheduler scheduler;
+        droid::core::TaskStats tickStats;
+        droid::core::TaskStats jitterStats;
+        std::vector<droid::core::BaseComponent*> components;
+        std::atomic<bool> failsafeRequested{false};
+        bool taskRunning = false;
+        uint32_t periodMicros = 0;
+        uint32_t nextTick = 0;
+
+        static void taskEntry(void* param);
+        void run();
+        void tick(uint32_t tickTime);
+        void publish();
+    };
+}
@@ -17,6 +17,7 @@ namespace droid::brain {
     class DomeMgr : public droid::core::BaseComponent {
     public:
         DomeMgr(const char* name, droid::core::System* system, droid::controller::Controller*, droid::motor::MotorDriver*);
+        static constexpr uint8_t TIMER_COUNT = 1;     //AutoDome deadline
 
         //Override virtual methods from BaseComponent
         void init() override;
@@ -24,9 +25,13 @@ namespace droid::brain {
         void task() override;
         void logConfig() override;
         void failsafe() override;
+        void configChanged(const char* nspace, const char* key) override;
+        void timerExpired(droid::core::TimerId timer) override;
 
     private:
         bool doAutoDome();
+        void deactivateAutoDome();
+        void loadConfig();
 
         droid::controller::Controller* controller = nullptr;
         droid::motor::MotorDriver* domeMotor = nullptr;
@@ -49,7 +54,6 @@ namespace droid::brain {
         bool autoDomeMoving = false;
         int16_t autoDomeAngle = 0;
         int8_t autoDomeSpeed = 0;
-        unsigned long autoDomeNextStop = 0;
-        unsigned long autoDomeNextMove = 0;
+        droid::core::TimerId autoDomeTimer = TIMER_NONE;
     };
 }
\ No newline at end of file
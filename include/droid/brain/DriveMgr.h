@@ -24,6 +24,7 @@ namespace droid::brain {
         void task() override;
         void logConfig() override;
         void failsafe() override;
+        void configChanged(const char* nspace, const char* key) override;
 
     private:
         droid::controller::Controller* controller = nullptr;
@@ -33,5 +34,8 @@ namespace droid::brain {
         int8_t turboSpeed = 0;
         int8_t turnSpeed = 0;
         int8_t deadband = 0;
+        droid::motor::MotorMixer::Mode driveMode = droid::motor::MotorMixer::ARCADE;
+
+        void loadConfig();
     };
 }
\ No newline at end of file
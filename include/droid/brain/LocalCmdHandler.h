@@ -16,7 +16,7 @@ namespace droid::brain {
     class LocalCmdHandler : public droid::command::CmdHandler {
     public:
         LocalCmdHandler(const char* name, droid::core::System* system, Brain* brain, Stream* console);
-        bool process(const char* device, const char* command);
+        bool execute(const char* command) override;
 
     private:
         Brain* brain = nullptr;
@@ -10,13 +10,15 @@
 
 #pragma once
 #include "droid/command/CmdHandler.h"
+#include "droid/services/PWMService.h"
+#include "droid/services/ServoEasing.h"
 #include "settings/hardware.config.h"
 
 namespace droid::brain {
     class PanelCmdHandler : public droid::command::CmdHandler {
     public:
         PanelCmdHandler(const char* name, droid::core::System* system);
-        bool process(const char* device, const char* command);
+        bool execute(const char* command) override;
 
         //Override default methods from CmdHandler
         void init() override;
@@ -26,12 +28,28 @@ namespace droid::brain {
         void failsafe() override;
 
     private:
+        enum MoveState {
+            MOVE_IDLE,
+            MOVE_WAITING,       //queued behind PANEL_MAX_ACCELERATING other panels
+            MOVE_RUNNING};
+
         struct {
             uint16_t openMicroSeconds = 0;
             uint16_t closeMicroSeconds = 0;
             uint16_t timeMilliSeconds = 0;
             uint8_t pwmOutput = 0;
             bool isOpen = false;
+            droid::services::ServoEasing::Curve ease = droid::services::ServoEasing::NONE;
+            uint16_t moveMilliSeconds = 0;
+            MoveState moveState = MOVE_IDLE;
+            uint16_t fromMicroSeconds = 0;
+            uint16_t targetMicroSeconds = 0;
+            uint16_t currentMicroSeconds = 0;   //Last pulse sent, 0 until the first move
+            uint32_t moveStartMs = 0;
         } panelDetails[LOCAL_PANEL_COUNT];
+        uint8_t movingCount = 0;                //Panels waiting or running
+
+        void moveTo(droid::services::PWMService* pwmService, uint8_t index, uint16_t targetMicroSeconds);
+        void cancelMove(uint8_t index);
     };
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "droid/core/BaseComponent.h"
 #include "droid/controller/Controller.h"
 #include "droid/command/CmdHandler.h"
+#include "droid/command/ActionProgram.h"
 #include "droid/core/InstructionList.h"
 #include <map>
 #include <vector>
@@ -32,18 +33,26 @@ namespace droid::command {
 
         void addCmdHandler(droid::command::CmdHandler*);
         void fireAction(const char* action);
+        void fireAction(uint16_t actionId);
         void queueCommand(const char* device, const char* command, unsigned long executeTime);
         void overrideCmdMap(const char* action, const char* cmd);
 
     private:
         droid::controller::Controller* controller = nullptr;
         std::map<String, String> cmdMap;
+        droid::core::NameTable* actionNames = nullptr;
         unsigned long lastActionTime = 0;
-        String lastAction = "";
+        uint16_t lastAction = NAMETABLE_NONE;
+        uint32_t lastActionSeq = 0;
         droid::core::InstructionList instructionList;
         std::vector<droid::command::CmdHandler*> cmdHandlers;
+        std::vector<droid::command::CmdHandler*> cmdMonitors;
+        std::vector<ActionProgram> programs;    //Indexed by Action id
+        ActionProgram adhocProgram;             //Reused for sequences that are not a named action
 
-        void parseCommands(const char* command);
+        void compileProgram(uint16_t actionId);
+        void compilePrograms();
+        void queueProgram(const ActionProgram& program);
         void executeCommands();
     };
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use.
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <vector>
+#include "droid/command/CmdHandler.h"
+#include "droid/core/InstructionList.h"
+
+namespace droid::command {
+    struct ActionStep {
+        unsigned long delayMs = 0;      //Relative to the time the action is fired
+        uint16_t device = 0;            //Offset of the device name in the program text
+        uint16_t command = 0;           //Offset of the command in the program text
+        uint8_t handler = INSTRUCTIONLIST_NO_TARGET;    //Index into the ActionMgr's cmdHandlers
+    };
+
+    /**
+     * @brief An action sequence ("Device>cmd;#delay;Device>cmd...") parsed once.
+     * Each command becomes a step with its delay from the start of the action and
+     * the handler for its device already resolved.  The name, device names and
+     * commands are stored back to back in one buffer (each device name only once),
+     * so firing a program only copies the command bytes into the InstructionList.
+     */
+    class ActionProgram {
+    public:
+        void compile(const char* name, const char* sequence, const std::vector<CmdHandler*>& cmdHandlers);
+
+        bool isCompiled() const {return !text.empty();}
+        const char* getName() const {return text.data();}
+        size_t size() const {return steps.size();}
+        const ActionStep& getStep(size_t index) const {return steps[index];}
+        const char* getText(uint16_t offset) const {return &text[offset];}
+
+        static uint8_t findHandler(const char* device, const std::vector<CmdHandler*>& cmdHandlers);
+
+    private:
+        std::vector<ActionStep> steps;
+        std::vector<char> text;
+
+        uint16_t intern(const char* str, size_t len);
+        uint16_t internDevice(const char* device, size_t len);
+    };
+}
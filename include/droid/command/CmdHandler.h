@@ -15,7 +15,9 @@ namespace droid::command {
     class CmdHandler : public droid::core::BaseComponent {
     public:
         CmdHandler(const char* name, droid::core::System* system) :
-            BaseComponent(name, system) {}
+            BaseComponent(name, system) {
+            setSchedule(SCHEDULE_HOUSEKEEPING_PERIOD_US, 0, SCHEDULE_PRIORITY_HOUSEKEEPING);
+        }
 
         //Virtual methods required by BaseComponent declared here as NOOPs for concrete sub-classes
         void init() {}
@@ -24,6 +26,35 @@ namespace droid::command {
         void logConfig() {}
         void failsafe() {}
 
-        virtual bool process(const char* device, const char* command) = 0;
+        /**
+         * @brief Execute the command if this handler owns the named device.
+         * @return true if the command was consumed
+         */
+        virtual bool process(const char* device, const char* command) {
+            if ((device == NULL) ||
+                (command == NULL) ||
+                !handlesDevice(device)) {
+                return false;
+            }
+            return execute(command);
+        }
+
+        /**
+         * @brief Whether this handler owns the named device.
+         * ActionMgr resolves the handler for each device once, when an action is
+         * compiled, and then passes the commands straight to execute().
+         */
+        virtual bool handlesDevice(const char* device) {
+            return (strcasecmp(name, device) == 0);
+        }
+
+        /**
+         * @brief Monitors are shown every command that is executed, but never consume one.
+         */
+        virtual bool isMonitor() {
+            return false;
+        }
+
+        virtual bool execute(const char* command) = 0;
     };
 }
\ No newline at end of file
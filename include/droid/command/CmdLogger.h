@@ -15,7 +15,9 @@ namespace droid::command {
     class CmdLogger : public CmdHandler {
     public:
         CmdLogger(const char* name, droid::core::System* sys);
-        bool process(const char* device, const char* command);
+        bool process(const char* device, const char* command) override;
+        bool execute(const char* command) override;
+        bool isMonitor() override;
 
     private:
         Stream* stream = nullptr;
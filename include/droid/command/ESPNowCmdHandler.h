@@ -15,6 +15,6 @@ namespace droid::command {
     class ESPNowCmdHandler : public CmdHandler {
     public:
         ESPNowCmdHandler(const char* name, droid::core::System* system);
-        bool process(const char* device, const char* command);
+        bool execute(const char* command) override;
     };
 }
\ No newline at end of file
@@ -15,7 +15,7 @@ namespace droid::command {
     class StreamCmdHandler : public CmdHandler {
     public:
         StreamCmdHandler(const char* name, droid::core::System* system, Stream* stream);
-        bool process(const char* device, const char* command);
+        bool execute(const char* command) override;
 
     private:
         Stream* stream = nullptr;
@@ -10,6 +10,7 @@
 
 #pragma once
 #include "droid/core/BaseComponent.h"
+#include "droid/controller/InputSnapshot.h"
 
 namespace droid::controller {
     class Controller : public droid::core::BaseComponent {
@@ -30,7 +31,10 @@ namespace droid::controller {
             STUB, DUAL_SONY, DUAL_RING, PS3_BT, PS3_USB};
 
         Controller(const char* name, droid::core::System* system) :
-            BaseComponent(name, system) {}
+            BaseComponent(name, system) {
+            //Controllers are polled on every pass so that no input is missed
+            setSchedule(0, 0, SCHEDULE_PRIORITY_INPUT);
+        }
         
         //Virtual methods from BaseComponent redeclared here for clarity
         virtual void init() = 0;
@@ -42,9 +46,22 @@ namespace droid::controller {
         virtual void setCritical(bool isCritical) = 0;
         //Joystick Position should be returned as a value between -100 and +100 for each axis
         virtual int8_t getJoystickPosition(Joystick, Axis) = 0;
-        //Return the MechMind Action associated with the active Trigger
-        virtual String getAction() = 0;
+        //Read the current button state, the bit layout is specific to each Controller type
+        virtual uint32_t readButtons() = 0;
+        //Return the id (in System::getActionNames) of the MechMind Action associated
+        //  with the Trigger active in buttons, or NAMETABLE_NONE
+        virtual uint16_t getAction(uint32_t buttons) = 0;
 
         virtual ControllerType getType() = 0;
+
+        //The inputs as of the last sample(), consumers read these rather than the
+        //  methods above so the input work is only done once per tick
+        virtual InputSnapshot getInput() {return input;}
+
+    protected:
+        InputSnapshot input;
+
+        //Read all inputs into the InputSnapshot, called at the end of each task()
+        void sample();
     };
 }
\ No newline at end of file
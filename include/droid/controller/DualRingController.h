@@ -9,6 +9,7 @@
  */
 
 #include "droid/controller/Controller.h"
+#include "droid/controller/TriggerTable.h"
 #include "droid/core/System.h"
 #include "shared/blering/DualRingBLE.h"
 #include <map>
@@ -29,7 +30,8 @@ namespace droid::controller {
         void setCritical(bool isCritical);
         //Joystick Position should be returned as a value between -100 and +100 for each axis
         int8_t getJoystickPosition(Joystick, Axis);
-        String getAction();
+        uint32_t readButtons();
+        uint16_t getAction(uint32_t buttons);
         ControllerType getType() {return DUAL_RING;}
 
     private:
@@ -37,8 +39,8 @@ namespace droid::controller {
 
         bool faultState = true;
         std::map<String, String> triggerMap;
+        TriggerTable triggerTable;
 
         void faultCheck();
-        String getTrigger();
     };
 }
\ No newline at end of file
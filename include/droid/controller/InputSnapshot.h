@@ -0,0 +1,30 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "droid/core/NameTable.h"
+
+namespace droid::controller {
+    /**
+     * @brief Everything read from a Controller during one tick.
+     * Sampled once per tick by the Controller and never modified afterwards, so
+     * every consumer of a tick sees the same joystick, button and Action state.
+     */
+    struct InputSnapshot {
+        int8_t joystick[2][2] = {{0}};      //[Joystick][Axis], -100 to +100
+        uint32_t buttons = 0;               //Bit layout is specific to each Controller type
+        uint16_t action = NAMETABLE_NONE;   //Most recent Action reported by the Controller
+        uint32_t actionSeq = 0;             //Incremented every tick that reported an Action
+        uint16_t heldAction = NAMETABLE_NONE;   //Action of the trigger held during this tick, NONE once released
+        unsigned long timestamp = 0;        //Clock millis() when sampled
+        uint32_t sequence = 0;              //Incremented every sample
+    };
+}
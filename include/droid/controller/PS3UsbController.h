@@ -12,6 +12,7 @@
 #include <PS3USB.h>
 
 #include "droid/controller/Controller.h"
+#include "droid/controller/TriggerTable.h"
 #include "droid/core/System.h"
 #include <map>
 
@@ -30,7 +31,8 @@ namespace droid::controller {
         void setCritical(bool isCritical);
         //Joystick Position should be returned as a value between -100 and +100 for each axis
         int8_t getJoystickPosition(Joystick, Axis);
-        String getAction();
+        uint32_t readButtons();
+        uint16_t getAction(uint32_t buttons);
         ControllerType getType() {return ControllerType::PS3_USB;}
 
     private:
@@ -59,11 +61,11 @@ namespace droid::controller {
         int8_t deadbandX = 0;
         int8_t deadbandY = 0;
         std::map<String, String> triggerMap;
+        TriggerTable triggerTable;
 
         void onInitPS3();
         void faultCheck(ControllerDetails* controller);
         void disconnect(ControllerDetails* controller);
-        String getTrigger();
 
         static void onInitPS3Wrapper() {
             instance->onInitPS3();
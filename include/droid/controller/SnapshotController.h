@@ -0,0 +1,57 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include "droid/controller/Controller.h"
+#include "droid/core/Snapshot.h"
+
+namespace droid::controller {
+    /**
+     * @brief Read-only Controller backed by an InputSnapshot Snapshot.
+     * Lets components running outside of the control task (ActionMgr) read
+     * the controller without touching the real Controller from another core.
+     * New Actions are detected through the InputSnapshot's actionSeq.
+     */
+    class SnapshotController : public Controller {
+    public:
+        SnapshotController(const char* name, droid::core::System* system, const droid::core::Snapshot<InputSnapshot>* snapshot, ControllerType type) :
+            Controller(name, system),
+            snapshot(snapshot),
+            type(type) {}
+
+        void init() override {}
+        void factoryReset() override {}
+        void task() override {}
+        void logConfig() override {}
+        void failsafe() override {}
+
+        //Criticality is owned by the control task
+        void setCritical(bool isCritical) override {}
+
+        int8_t getJoystickPosition(Joystick joystick, Axis axis) override {
+            return snapshot->read().joystick[joystick][axis];
+        }
+
+        uint32_t readButtons() override {
+            return snapshot->read().buttons;
+        }
+
+        //Actions are only published through getInput()
+        uint16_t getAction(uint32_t buttons) override {return NAMETABLE_NONE;}
+
+        InputSnapshot getInput() override {return snapshot->read();}
+
+        ControllerType getType() override {return type;}
+
+    private:
+        const droid::core::Snapshot<InputSnapshot>* snapshot = nullptr;
+        ControllerType type = STUB;
+    };
+}
@@ -19,14 +19,15 @@ namespace droid::controller {
 
         void init() override {}
         void factoryReset() override {}
-        void task() override {}
+        void task() override {sample();}
         void logConfig() override {}
         void failsafe() override {}
 
         void setCritical(bool isCritical) {}
         void setDeadband(int8_t deadband) {}
         int8_t getJoystickPosition(Joystick, Axis) {return 0;}
-        String getAction() {return "";}
+        uint32_t readButtons() {return 0;}
+        uint16_t getAction(uint32_t buttons) {return NAMETABLE_NONE;}
         ControllerType getType() {return STUB;}
     };
 }
@@ -0,0 +1,66 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <map>
+#include <vector>
+#include "droid/core/NameTable.h"
+
+#define TRIGGERTABLE_MAX_BUTTONS    32
+#define TRIGGERTABLE_MAX_MODIFIERS  8
+
+namespace droid::controller {
+    /**
+     * @brief One group of triggers sharing the same modifier condition.
+     * Masks use the controller's button bit numbering.  Each base button in the
+     * layer names the trigger prefix + buttonName + suffix (e.g. "LX_" + "Rup").
+     */
+    struct TriggerLayer {
+        const char* prefix;
+        const char* suffix;
+        uint32_t required;      //Buttons that must all be pressed
+        uint32_t forbidden;     //Buttons that must not be pressed
+        uint32_t bases;         //Buttons that fire a trigger in this layer
+    };
+
+    /**
+     * @brief A Controller's triggerMap turned into a table indexed by button bitmask.
+     * The Controller reads its buttons once per loop into a mask and getAction()
+     * decodes it without any string handling: the pressed modifiers select a
+     * precomputed row, the row holds the Action id for each base button.
+     * Layers are listed in priority order, when several triggers match the one
+     * listed first wins, just like the if/else chains these tables replace.
+     * Built once from the "trigger" = "action" map after the config overrides are
+     * loaded; each Action is interned in the System's action NameTable.
+     */
+    class TriggerTable {
+    public:
+        void build(const std::map<String, String>& triggerMap, droid::core::NameTable* actionNames,
+                   const char* const* buttonNames, uint8_t buttonCount,
+                   const TriggerLayer* layers, uint8_t layerCount);
+        //Returns the id of the Action triggered by the buttons, or NAMETABLE_NONE
+        uint16_t getAction(uint32_t buttons) const;
+
+    private:
+        struct Cell {
+            uint16_t action;
+            uint16_t rank;      //Position of the trigger in the layer order
+        };
+        struct Row {
+            uint32_t bases;     //Base buttons with a trigger in this row
+            uint16_t first;     //Index of the first Cell, one Cell per bit in bases
+        };
+
+        std::vector<uint8_t> modifierBits;      //Bit number of each modifier button
+        std::vector<uint8_t> rowIndex;          //Indexed by the set of pressed modifiers
+        std::vector<Row> rows;
+        std::vector<Cell> cells;
+    };
+}
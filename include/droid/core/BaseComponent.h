@@ -11,8 +11,27 @@
 #pragma once
 #include "droid/core/System.h"
 
+//Scheduling priorities, lower values run first when several components are due at once
+#define SCHEDULE_PRIORITY_INPUT         0
+#define SCHEDULE_PRIORITY_CONTROL       1
+#define SCHEDULE_PRIORITY_OUTPUT        2
+#define SCHEDULE_PRIORITY_NORMAL        3
+#define SCHEDULE_PRIORITY_HOUSEKEEPING  4
+
 namespace droid::core {
-    class BaseComponent {
+    /**
+     * @brief How often the Scheduler should run a component's task().
+     * A periodMicros of 0 means the task runs on every pass of the main loop.
+     * phaseMicros delays the first run so that components sharing a period
+     * can be spread across it instead of all coming due on the same pass.
+     */
+    struct Schedule {
+        uint32_t periodMicros = 0;
+        uint32_t phaseMicros = 0;
+        uint8_t priority = SCHEDULE_PRIORITY_NORMAL;
+    };
+
+    class BaseComponent : public ConfigListener, public TimerListener {
     public:
         /**
          * @brief Constructor for a new BaseComponent.
@@ -29,7 +48,10 @@ namespace droid::core {
             system(system),
             logger(system->getLogger()),
             config(system->getConfig()),
-            droidState(system->getDroidState()) {}
+            clock(system->getClock()),
+            droidState(system->getDroidState()),
+            timers(system->getTimers()),
+            logId(logger->getLogId(name)) {}
 
         virtual void init() = 0;
         virtual void factoryReset() = 0;
@@ -37,11 +59,56 @@ namespace droid::core {
         virtual void logConfig() = 0;
         virtual void failsafe() = 0;
 
+        /**
+         * @brief Called by the Scheduler running this component, before its next task(),
+         * when a Config value it subscribed to (in init()) has changed.
+         */
+        void configChanged(const char* nspace, const char* key) override {}
+
+        /**
+         * @brief Called by the Scheduler running this component, before its next task(),
+         * when a timer it created with createTimer() expires.
+         */
+        void timerExpired(TimerId timer) override {}
+
+        const Schedule& getSchedule() const {
+            return schedule;
+        }
+
+        //Set by the Scheduler the component is added to, its timers fire from that Scheduler
+        void setTimerLane(uint8_t lane) {
+            timerLane = lane;
+        }
+
         const char* name;
     protected:
+        void setSchedule(uint32_t periodMicros, uint32_t phaseMicros, uint8_t priority) {
+            schedule.periodMicros = periodMicros;
+            schedule.phaseMicros = phaseMicros;
+            schedule.priority = priority;
+        }
+
+        //Timer of this component, create them in init() (once added to a Scheduler).  A timer
+        //  that cannot be created is logged at ERROR, which fails the droid safe.
+        TimerId createTimer() {
+            TimerId timer = timers->create(this, timerLane);
+            if (timer == TIMER_NONE) {
+                logger->log(logId, ERROR, "Unable to create a timer, %s\n",
+                    (timerLane == TIMER_LANE_NONE) ? "component is not in a Scheduler" : "TIMERSERVICE_MAX_TIMERS is too small");
+            }
+            return timer;
+        }
+
         droid::core::System* system = nullptr;
         Logger* logger = nullptr;
         Config* config = nullptr;
+        Clock* clock = nullptr;
         droid::services::DroidState* droidState = nullptr;
+        TimerService* timers = nullptr;
+        LogId logId = LOGGER_DEFAULT_ID;    //name, interned by the Logger
+
+    private:
+        Schedule schedule;
+        uint8_t timerLane = TIMER_LANE_NONE;
     };
 }
\ No newline at end of file
@@ -13,7 +13,10 @@
 
 #define INSTRUCTIONLIST_DEVICE_LEN  20
 #define INSTRUCTIONLIST_COMMAND_LEN 50
-#define INSTRUCTIONLIST_QUEUE_SIZE  20
+#ifndef INSTRUCTIONLIST_QUEUE_SIZE
+#define INSTRUCTIONLIST_QUEUE_SIZE  64  //At most 255
+#endif
+#define INSTRUCTIONLIST_NO_TARGET   0xFF
 
 namespace droid::core {
 
@@ -21,23 +24,52 @@ namespace droid::core {
         char device[INSTRUCTIONLIST_DEVICE_LEN] = {0};
         char command[INSTRUCTIONLIST_COMMAND_LEN] = {0};
         unsigned long executeTime = 0; // Time when the instruction should be executed
+        uint32_t sequence = 0;         // Order added, keeps instructions due at the same time in FIFO order
+        uint8_t target = INSTRUCTIONLIST_NO_TARGET; // Optional index of the receiver, resolved by the owner of the list
         bool isActive = 0;
-        Instruction* next = NULL;
-        Instruction* prev = NULL;
     };
 
+    /**
+     * @brief Fixed pool of Instructions ordered by executeTime.
+     * The pending instructions are kept in a binary min-heap so checking whether
+     * anything is due is O(1) and adding or removing an instruction is O(log n),
+     * regardless of the queue size.  Times are compared wrap-safe, so instructions
+     * scheduled across a millis() rollover still execute in order.
+     */
     class InstructionList {
     public:
-        Instruction* addInstruction();
-        Instruction* deleteInstruction(Instruction*);  //Note, this method returns the NEXT Instruction* in the list
-        Instruction* initLoop();
-        Instruction* getNext(Instruction*);
+        InstructionList();
+
+        /**
+         * @brief Reserve an Instruction that will become due at executeTime.
+         * The caller fills in the device and command before the list is next read.
+         * @return the Instruction, or NULL if the list is full
+         */
+        Instruction* addInstruction(unsigned long executeTime);
+
+        /**
+         * @brief Remove the earliest Instruction if it is due at the given time.
+         * The Instruction is copied to out and its slot freed before returning, so
+         * it is safe to add new instructions while processing it.
+         * @return true if an Instruction was due and copied to out
+         */
+        bool popDue(unsigned long now, Instruction& out);
+
+        bool isDue(unsigned long now) const;
+        uint8_t size() const {return count;}
         void clear();
         void dump(const char *name, Logger* logger, LogLevel level);
 
     private:
         Instruction list[INSTRUCTIONLIST_QUEUE_SIZE];
-        Instruction* head = NULL;
-        Instruction* tail = NULL;
+        Instruction* heap[INSTRUCTIONLIST_QUEUE_SIZE];  //heap[0] is the next Instruction due
+        uint8_t freeList[INSTRUCTIONLIST_QUEUE_SIZE];   //indexes of the unused records in list
+        uint8_t freeCount = 0;
+        uint8_t count = 0;
+        uint32_t nextSequence = 0;
+
+        static bool isEarlier(const Instruction* a, const Instruction* b);
+        void siftUp(uint8_t index);
+        void siftDown(uint8_t index);
     };
 }
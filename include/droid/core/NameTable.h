@@ -0,0 +1,38 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <vector>
+
+#define NAMETABLE_NONE  0   //Id reserved for "no name"
+
+namespace droid::core {
+    /**
+     * @brief Interns names (Actions, Triggers) as small integer ids so they can be
+     * passed around and used to index tables without copying or comparing strings.
+     * Each name is copied once and kept for the life of the program.
+     * intern() and find() compare strings and are meant for init and console
+     * commands, getName() is O(1).  Not thread safe, intern from the main loop only.
+     */
+    class NameTable {
+    public:
+        NameTable();
+
+        uint16_t intern(const char* name);
+        uint16_t find(const char* name) const;
+        const char* getName(uint16_t id) const;
+        //Number of ids, including NAMETABLE_NONE
+        uint16_t size() const {return names.size();}
+
+    private:
+        std::vector<const char*> names;
+    };
+}
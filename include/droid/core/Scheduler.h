@@ -0,0 +1,67 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <vector>
+#include "droid/core/BaseComponent.h"
+#include "droid/core/TaskStats.h"
+
+namespace droid::core {
+
+    struct ScheduledTask {
+        BaseComponent* component = nullptr;
+        Schedule schedule;
+        uint32_t nextRun = 0;       //Clock micros() at which the task is next due
+        uint32_t overruns = 0;      //number of periods skipped because the task ran late
+        TaskStats stats;
+    };
+
+    /**
+     * @brief Runs the task() of each registered component when it is due.
+     * Tasks are kept ordered by their next due time, so a pass where nothing
+     * is due costs a single comparison.  When several tasks are due on the
+     * same pass they run in priority order, then earliest deadline first.
+     * Periodic tasks keep their phase: a task that falls behind skips the
+     * missed periods (counted as overruns) rather than running back to back.
+     * Due times follow the System Clock, task execution times are always
+     * measured in real time.  Config changes subscribed to by the components
+     * and the expiry of their timers are dispatched at the start of a pass, so
+     * they never land mid-task.
+     */
+    class Scheduler {
+    public:
+        Scheduler(Logger* logger, Clock* clock, Config* config, TimerService* timers, uint32_t taskDeadlineMicros);
+
+        void add(BaseComponent* component);
+        void start();
+        void start(uint32_t now);
+        void run();
+        void run(uint32_t now);
+
+        size_t size() const {return tasks.size();}
+        const ScheduledTask& getTask(size_t index) const {return tasks[index];}
+        void resetStats();
+
+    private:
+        Logger* logger = nullptr;
+        Clock* clock = nullptr;
+        Config* config = nullptr;
+        TimerService* timers = nullptr;
+        uint8_t timerLane = TIMER_LANE_NONE;
+        uint32_t taskDeadlineMicros = 0;
+        uint32_t configChanges = 0;     //Config change count at the last dispatch
+        std::vector<ScheduledTask> tasks;
+        std::vector<uint8_t> order;     //indexes into tasks, sorted by nextRun
+        std::vector<uint8_t> dueList;   //scratch list of the tasks due on this pass
+
+        void runTask(ScheduledTask& task, uint32_t now);
+        void sortOrder();
+    };
+}
@@ -0,0 +1,68 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+namespace droid::core {
+    /**
+     * @brief Lock-free single-writer / multi-reader snapshot of a value (a seqlock).
+     * The writer never blocks; readers retry if they raced with a write, so they
+     * always get a consistent copy of the most recently published value.
+     * T must be trivially copyable (no Strings or pointers to owned data).
+     */
+    template <typename T>
+    class Snapshot {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot<T> requires a trivially copyable T");
+
+    public:
+        void write(const T& value) {
+            uint32_t seq = sequence.load(std::memory_order_relaxed);
+            sequence.store(seq + 1, std::memory_order_relaxed);     //odd = write in progress
+            std::atomic_thread_fence(std::memory_order_release);
+            copyData(data, &value);
+            std::atomic_thread_fence(std::memory_order_release);
+            sequence.store(seq + 2, std::memory_order_relaxed);
+        }
+
+        T read() const {
+            T value;
+            while (true) {
+                uint32_t before = sequence.load(std::memory_order_acquire);
+                if ((before & 1) == 0) {
+                    copyData(&value, data);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (sequence.load(std::memory_order_relaxed) == before) {
+                        return value;
+                    }
+                }
+            }
+        }
+
+        //Incremented by two on every write, can be used to detect new values without copying them
+        uint32_t getSequence() const {
+            return sequence.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::atomic<uint32_t> sequence{0};
+        volatile uint8_t data[sizeof(T)] = {0};
+
+        static void copyData(volatile void* dest, const volatile void* src) {
+            volatile uint8_t* d = (volatile uint8_t*) dest;
+            const volatile uint8_t* s = (const volatile uint8_t*) src;
+            for (size_t i = 0; i < sizeof(T); i++) {
+                d[i] = s[i];
+            }
+        }
+    };
+}
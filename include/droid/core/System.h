@@ -9,9 +9,12 @@
  */
 
 #pragma once
+#include "shared/common/Clock.h"
 #include "shared/common/Config.h"
 #include "shared/common/Logger.h"
 #include "droid/services/DroidState.h"
+#include "droid/core/NameTable.h"
+#include "droid/core/TimerService.h"
 
 // Forward declaration of PWMService
 namespace droid::services {
@@ -21,17 +24,31 @@ namespace droid::services {
 namespace droid::core {
     class System {
     public:
-        System(Stream* out, LogLevel defaultLogLevel);
+        /**
+         * @brief Construct the System.
+         * @param clock source of time for every component, a RealClock is used when nullptr.
+         * The clock must outlive the System and cannot be changed afterwards, components
+         * keep the pointer from construction.
+         */
+        System(Stream* out, LogLevel defaultLogLevel, Clock* clock = nullptr);
+        Clock* getClock();
         Config* getConfig();
         Logger* getLogger();
         void setPWMService(droid::services::PWMService*);
         droid::services::PWMService* getPWMService();
         droid::services::DroidState* getDroidState();
+        //Ids for the names of MechMind Actions, shared by the Controllers and ActionMgr
+        NameTable* getActionNames();
+        TimerService* getTimers();
 
     private:
+        RealClock realClock;
+        Clock* clock;
         Config config;
         Logger logger;
         droid::services::DroidState droidState;
+        NameTable actionNames;
+        TimerService timers;
         droid::services::PWMService* pwmService = nullptr;
     };
 }
\ No newline at end of file
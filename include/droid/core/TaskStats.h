@@ -0,0 +1,61 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <Arduino.h>
+
+//Durations below this many microseconds each get their own bucket
+#define TASKSTATS_LINEAR_LIMIT     8
+//Each power of two above the linear range is split into this many buckets
+#define TASKSTATS_SUB_BUCKETS      4
+//Durations are clamped to 2^TASKSTATS_MAX_BITS microseconds (~16 seconds)
+#define TASKSTATS_MAX_BITS         24
+#define TASKSTATS_BUCKET_COUNT     (TASKSTATS_LINEAR_LIMIT + ((TASKSTATS_MAX_BITS - 3) * TASKSTATS_SUB_BUCKETS))
+
+namespace droid::core {
+    /**
+     * @brief Fixed-memory timing statistics for a periodic task.
+     * Durations (in microseconds) are counted in log-bucketed histogram bins,
+     * so percentiles are reported with at most 25% (one bucket) error while 
+     * using the same small amount of RAM regardless of how many samples are recorded.
+     */
+    class TaskStats {
+    public:
+        void record(uint32_t micros);
+        void reset();
+        void setDeadline(uint32_t micros);
+
+        uint32_t getCount() const {return count;}
+        uint32_t getMax() const {return maxMicros;}
+        uint32_t getDeadlineMisses() const {return deadlineMisses;}
+        uint32_t getDeadline() const {return deadlineMicros;}
+        uint32_t getMean() const;
+
+        /**
+         * @brief Return the duration below which the requested percent of all
+         * samples fall.  The result is the upper bound of the histogram bucket
+         * containing the percentile, capped at the largest sample recorded.
+         * 
+         * @param percent (0 - 100)
+         */
+        uint32_t getPercentile(uint8_t percent) const;
+
+    private:
+        uint32_t buckets[TASKSTATS_BUCKET_COUNT] = {0};
+        uint32_t count = 0;
+        uint32_t maxMicros = 0;
+        uint64_t totalMicros = 0;
+        uint32_t deadlineMicros = 0;
+        uint32_t deadlineMisses = 0;
+
+        static uint8_t bucketFor(uint32_t micros);
+        static uint32_t bucketUpperBound(uint8_t bucket);
+    };
+}
@@ -0,0 +1,88 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use.
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <mutex>
+#include "shared/common/Clock.h"
+#include "settings/hardware.config.h"
+
+#define TIMER_NONE          0xFF    //TimerId returned when no timer could be created
+#define TIMER_LANE_NONE     0xFF    //Lane of a component not added to a Scheduler
+
+static_assert(TIMERSERVICE_MAX_TIMERS < TIMER_NONE, "TIMERSERVICE_MAX_TIMERS must leave TIMER_NONE unused");
+static_assert(TIMERSERVICE_MAX_LANES < TIMER_LANE_NONE, "TIMERSERVICE_MAX_LANES must leave TIMER_LANE_NONE unused");
+
+namespace droid::core {
+    typedef uint8_t TimerId;
+
+    class TimerListener {
+    public:
+        virtual void timerExpired(TimerId timer) = 0;
+    };
+
+    /**
+     * @brief One-shot and periodic timers shared by every component, so deadlines
+     * are registered once instead of being polled on every task().
+     * Each Scheduler is a lane: timers fire from run() at the start of a pass of the
+     * Scheduler that runs their listener, on the same task as the listener's task().
+     * The running timers of each lane are kept in a list of their own, ordered by due
+     * time, so a pass with nothing due on its lane costs one comparison and takes no
+     * lock, whatever is due on the other lanes.
+     * start() and cancel() can be called from any task.  A timer restarted or
+     * cancelled while its expiry is being delivered may still get that callback, so
+     * listeners check their own state.  Timers are created in init(), never freed.
+     */
+    class TimerService {
+    public:
+        TimerService(Clock* clock);
+
+        uint8_t addLane();
+        TimerId create(TimerListener* listener, uint8_t lane);
+        //(Re)arms a timer to fire in delayMs, then every periodMs when periodMs is not 0
+        void start(TimerId timer, uint32_t delayMs, uint32_t periodMs = 0);
+        void cancel(TimerId timer);
+        bool isRunning(TimerId timer);
+        //Clock millis() at which a running timer is due
+        uint32_t getDueAt(TimerId timer);
+
+        void run(uint8_t lane);
+        void run(uint8_t lane, uint32_t now);
+
+    private:
+        struct Timer {
+            TimerListener* listener = nullptr;
+            uint32_t dueAt = 0;
+            uint32_t periodMs = 0;
+            uint8_t lane = TIMER_LANE_NONE;
+            bool running = false;
+        };
+
+        struct Lane {
+            uint8_t order[TIMERSERVICE_MAX_TIMERS];     //Running timers of the lane, sorted by dueAt
+            uint8_t runningCount = 0;
+            //Copies of runningCount and the first dueAt, for the lock free check of run()
+            std::atomic<uint8_t> pending{0};
+            std::atomic<uint32_t> firstDueAt{0};
+        };
+
+        Clock* clock = nullptr;
+        std::mutex lock;
+        Timer timers[TIMERSERVICE_MAX_TIMERS];
+        uint8_t timerCount = 0;
+        Lane lanes[TIMERSERVICE_MAX_LANES];
+        uint8_t laneCount = 0;
+
+        void insert(TimerId timer);
+        void remove(TimerId timer);
+        void publish(Lane& lane);
+    };
+}
@@ -19,6 +19,7 @@ namespace droid::motor {
     public:
 
         CytronSmartDriveDuoDriver(const char* name, droid::core::System* system, byte address, Stream* port, uint8_t initialByte = 0x80);
+        static constexpr uint8_t TIMER_COUNT = 1;     //Command timeout
 
         //Override virtual methods from MotorDriver/BaseComponent
         void init() override;
@@ -26,11 +27,12 @@ namespace droid::motor {
         void task() override;
         void logConfig() override;
         void failsafe() override;
+        void configChanged(const char* nspace, const char* key) override;
+        void timerExpired(droid::core::TimerId timer) override;
 
         //Motor speed should be specified in a range from -100 to +100
         bool setMotorSpeed(uint8_t motor, int8_t speed);
-        //Joystick Positions should be a value between -100 and +100 for each axis
-        bool arcadeDrive(int8_t joystickX, int8_t joystickY);
+        bool setMotorSpeeds(int8_t leftSpeed, int8_t rightSpeed) override;
         void stop();
 
     private:
@@ -41,6 +43,12 @@ namespace droid::motor {
         uint16_t timeoutMs = 0;
         ulong lastCommandMs = 0;
         ulong lastUpdateMs = 0;
+        droid::core::TimerId timeoutTimer = TIMER_NONE;
+
+        void loadConfig();
+        int8_t toNative(int8_t speed);
+        bool isMoving();
+        void armTimeout(bool wasMoving);
     };
 
     class CytronSmartDriveDuoMDDS10Driver : public CytronSmartDriveDuoDriver
@@ -10,12 +10,16 @@
 
 #pragma once
 #include "droid/core/BaseComponent.h"
+#include "droid/motor/MotorMixer.h"
 
 namespace droid::motor {
     class MotorDriver : public droid::core::BaseComponent {
     public:
         MotorDriver(const char* name, droid::core::System* system) :
-            BaseComponent(name, system) {}
+            BaseComponent(name, system) {
+            //Runs after the Managers so that new speeds are applied in the same control tick
+            setSchedule(SCHEDULE_CONTROL_PERIOD_US, 0, SCHEDULE_PRIORITY_OUTPUT);
+        }
             
         //Virtual methods from BaseComponent redeclared here for clarity
         virtual void init() = 0;
@@ -26,8 +30,23 @@ namespace droid::motor {
 
         //Motor speed should be specified in a range from -100 to +100
         virtual bool setMotorSpeed(uint8_t motor, int8_t speed) = 0;
-        //Joystick Positions should be a value between -100 and +100 for each axis
-        virtual bool arcadeDrive(int8_t joystickX, int8_t joystickY) = 0;
+        //Both motors of a dual channel driver (0 is left, 1 is right) in one command,
+        //  drivers that can update them together override this
+        virtual bool setMotorSpeeds(int8_t leftSpeed, int8_t rightSpeed) {
+            bool supported = setMotorSpeed(0, leftSpeed);
+            supported &= setMotorSpeed(1, rightSpeed);
+            return supported;
+        }
         virtual void stop() = 0;
+
+        //Inputs should be a value between -100 and +100, see MotorMixer::Mode for their meaning
+        bool drive(MotorMixer::Mode mode, int8_t inputA, int8_t inputB) {
+            MotorSpeeds speeds = MotorMixer::mix(mode, inputA, inputB);
+            return setMotorSpeeds(speeds.left, speeds.right);
+        }
+        //Joystick Positions should be a value between -100 and +100 for each axis
+        bool arcadeDrive(int8_t joystickX, int8_t joystickY) {
+            return drive(MotorMixer::ARCADE, joystickX, joystickY);
+        }
     };
 }
\ No newline at end of file
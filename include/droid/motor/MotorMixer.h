@@ -0,0 +1,75 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use.
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <Arduino.h>
+
+namespace droid::motor {
+    //Speeds of the two motors of a differential drive, -100 to +100
+    struct MotorSpeeds {
+        int8_t left = 0;
+        int8_t right = 0;
+    };
+
+    /**
+     * @brief Turns two normalized (-100 to +100) inputs into the speeds of the
+     * left and right motors, once per tick, so that a dual channel driver can be
+     * given both speeds in a single command (MotorDriver::setMotorSpeeds).
+     */
+    class MotorMixer {
+    public:
+        enum Mode {
+            ARCADE,         //inputs are turn and forward, speeds are clipped at +-100
+            TANK,           //inputs are the left and right speeds
+            CURVATURE};     //inputs are turn and forward, turn sets the curve radius instead of the
+                            //  speed difference, turns in place when forward is 0
+
+        static MotorSpeeds mix(Mode mode, int8_t inputA, int8_t inputB) {
+            int turn = clip(inputA);
+            int forward = clip(inputB);
+            int left;
+            int right;
+            switch (mode) {
+                case TANK:
+                    left = clip(inputA);
+                    right = clip(inputB);
+                    break;
+
+                case CURVATURE:
+                    if (forward != 0) {
+                        //Scale both sides down together so the curve is kept at full speed
+                        left = forward + (abs(forward) * turn) / 100;
+                        right = forward - (abs(forward) * turn) / 100;
+                        int largest = std::max(abs(left), abs(right));
+                        if (largest > 100) {
+                            left = (left * 100) / largest;
+                            right = (right * 100) / largest;
+                        }
+                        break;
+                    }
+                    //Fall through to spin in place
+                case ARCADE:
+                default:
+                    left = forward + turn;
+                    right = forward - turn;
+                    break;
+            }
+            MotorSpeeds speeds;
+            speeds.left = clip(left);
+            speeds.right = clip(right);
+            return speeds;
+        }
+
+    private:
+        static int clip(int value) {
+            return std::max(-100, std::min(100, value));
+        }
+    };
+}
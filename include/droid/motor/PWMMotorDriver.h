@@ -15,6 +15,7 @@ namespace droid::motor {
     class PWMMotorDriver : public MotorDriver {
     public:
         PWMMotorDriver(const char* name, droid::core::System* system, int8_t M0_out1, int8_t M0_out2, int8_t M1_out1, int8_t M1_out2);
+        static constexpr uint8_t TIMER_COUNT = 2;     //One command timeout per motor
 
         //Override virtual methods from MotorDriver/BaseComponent
         void init() override;
@@ -22,15 +23,18 @@ namespace droid::motor {
         void task() override;
         void logConfig() override;
         void failsafe() override;
+        void configChanged(const char* nspace, const char* key) override;
+        void timerExpired(droid::core::TimerId timer) override;
 
         //Motor speed should be specified in a range from -100 to +100
         bool setMotorSpeed(uint8_t motor, int8_t speed);
-        //Joystick Positions should be a value between -100 and +100 for each axis
-        bool arcadeDrive(int8_t joystickX, int8_t joystickY);
+        bool setMotorSpeeds(int8_t leftSpeed, int8_t rightSpeed) override;
         void stop();
 
     private:
         void setDutyCycle(uint8_t motor, int8_t speed);
+        void requestSpeed(uint8_t motor, int8_t speed);
+        void loadConfig();
         
         struct {
             // Pin Numbers
@@ -41,6 +45,7 @@ namespace droid::motor {
             uint8_t deadband = 0;
             float_t rampPowerPerMs = 1.0;
             ulong lastCommandMs = 0;
+            droid::core::TimerId commandTimer = TIMER_NONE;    //Stops the motor when commands stop coming
             ulong lastUpdateMs = 0;
             int8_t requestedDutyCycle = 0;
             int8_t currentDutyCycle = 0;
@@ -15,7 +15,9 @@ namespace droid::motor {
     class StubMotorDriver : public MotorDriver {
     public:
         StubMotorDriver(const char* name, droid::core::System* system) :
-            MotorDriver(name, system) {}
+            MotorDriver(name, system) {
+            setSchedule(SCHEDULE_HOUSEKEEPING_PERIOD_US, 0, SCHEDULE_PRIORITY_HOUSEKEEPING);
+        }
 
         void init() {}
         void factoryReset() {}
@@ -24,7 +26,7 @@ namespace droid::motor {
         void failsafe() {}
 
         bool setMotorSpeed(uint8_t motor, int8_t speed) {return true;}
-        bool arcadeDrive(int8_t joystickX, int8_t joystickY) {return true;}
+        bool setMotorSpeeds(int8_t leftSpeed, int8_t rightSpeed) {return true;}
         void stop() {}
     };
 }
@@ -9,17 +9,19 @@
  */
 
 #pragma once
+#include <atomic>
 
 namespace droid::services {
+    //Shared by the main loop (commands) and the control task (DriveMgr, DomeMgr)
     struct DroidState {
-        bool stickEnable = 1;
-        bool turboSpeed = 0;
-        bool autoDomeEnable = 1;
-        bool domePanelsOpen = 0;
-        bool bodyPanelsOpen = 0;
-        bool holosActive = 0;
-        bool holoLightsActive = 0;
-        bool musingEnabled = 0;
-        bool gestureMode = 0;
+        std::atomic<bool> stickEnable{true};
+        std::atomic<bool> turboSpeed{false};
+        std::atomic<bool> autoDomeEnable{true};
+        std::atomic<bool> domePanelsOpen{false};
+        std::atomic<bool> bodyPanelsOpen{false};
+        std::atomic<bool> holosActive{false};
+        std::atomic<bool> holoLightsActive{false};
+        std::atomic<bool> musingEnabled{false};
+        std::atomic<bool> gestureMode{false};
     };
 }
\ No newline at end of file
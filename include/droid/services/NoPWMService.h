@@ -15,7 +15,9 @@ namespace droid::services {
     class NoPWMService : public PWMService {
     public:
         NoPWMService(const char* name, droid::core::System* system) :
-            PWMService(name, system) {}
+            PWMService(name, system) {
+            setSchedule(SCHEDULE_HOUSEKEEPING_PERIOD_US, 0, SCHEDULE_PRIORITY_HOUSEKEEPING);
+        }
 
         void init() override {}
         void factoryReset() override {}
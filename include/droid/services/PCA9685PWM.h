@@ -11,14 +11,34 @@
 #pragma once
 #include "droid/services/PWMService.h"
 #include <Adafruit_PWMServoDriver.h>
+#include <mutex>
 
-#define NUMBER_OF_PWM_OUTPUTS 16
+#define PWM_OUTPUTS_PER_BOARD 16            //Outputs of each board
+#define PCA9685PWM_UNKNOWN_REG 0xFFFF       //Register value not known, the next write always goes out
 
 namespace droid::services {
+    //One board of a PCA9685PWM chain, see PCA9685_BOARDS in settings/hardware.config.h
+    struct PCA9685BoardConfig {
+        uint8_t address;
+        uint16_t frequencyHz;
+    };
+
+    /**
+     * @brief PWMService for one or more PCA9685 boards on the same I2C bus.  The
+     * outputs are numbered across the boards: board n has outputs n * 16 to
+     * n * 16 + 15, each board has its own PWM frequency.  Outputs are only written
+     * by task(), each board sends just its changed outputs, in bursts.  task() runs
+     * on the control task, which is the only one using the I2C bus: set*() from
+     * the main loop just update the shadow registers under busLock.  Output
+     * timeouts share one timer, armed at the earliest disableAt, so no pass looks
+     * at the outputs until one is due.
+     */
     class PCA9685PWM : public PWMService {
     public:
         PCA9685PWM(const char* name, droid::core::System* system, const uint8_t I2CAddress, uint8_t outputEnablePin = 0);
         PCA9685PWM(const char* name, droid::core::System* system, const uint8_t I2CAddress, TwoWire &i2c, uint8_t outputEnablePin = 0);
+        PCA9685PWM(const char* name, droid::core::System* system, const PCA9685BoardConfig* boardConfigs, uint8_t boardCount, TwoWire &i2c, uint8_t outputEnablePin = 0);
+        static constexpr uint8_t TIMER_COUNT = 1;     //Output disable deadline
 
         //Override virtual methods from PWMService/BaseComponent
         void init() override;
@@ -26,17 +46,47 @@ namespace droid::services {
         void task() override;
         void logConfig() override;
         void failsafe() override;
+        void timerExpired(droid::core::TimerId timer) override;
 
         void setPWMuS(uint8_t outNum, uint16_t pulseMicroseconds, uint16_t durationMilliseconds = 0) override;
         void setPWMpercent(uint8_t outNum, uint8_t percent, uint16_t durationMilliseconds = 0) override;
 
     private:
-        Adafruit_PWMServoDriver pca9685Driver;
-        bool initialized = false;
+        //Shadow of the LEDn_ON/LEDn_OFF registers: set*() only change pending and mark the
+        //  output dirty, flushBoard() writes the outputs that differ from written in bursts
+        struct ChannelRegs {
+            uint16_t on = PCA9685PWM_UNKNOWN_REG;
+            uint16_t off = PCA9685PWM_UNKNOWN_REG;
+        };
+
+        struct Board {
+            Adafruit_PWMServoDriver* driver = nullptr;
+            uint8_t address = 0;
+            uint16_t frequencyHz = 0;
+            bool initialized = false;
+            uint8_t prescale = 0;       //Read once in init(), for setPWMuS()
+            ChannelRegs written[PWM_OUTPUTS_PER_BOARD];
+            ChannelRegs pending[PWM_OUTPUTS_PER_BOARD];
+            uint16_t dirty = 0;         //One bit per output
+            uint16_t timed = 0;         //Outputs that are on until their disableAt
+            uint32_t disableAt[PWM_OUTPUTS_PER_BOARD] = {0};
+        };
+
+        TwoWire* i2c = nullptr;
+        //Guards the shadow registers, set from both the control task (motors) and the main
+        //  loop (panels).  Never held across an I2C write.
+        std::mutex busLock;
         uint8_t outputEnablePin = 0;
-        struct {
-            bool isActive = false;
-            uint32_t disableAt = 0;
-        } outDetails[NUMBER_OF_PWM_OUTPUTS];
+        Board boards[PCA9685_MAX_BOARDS];
+        uint8_t boardCount = 0;
+        droid::core::TimerId disableTimer = TIMER_NONE;
+
+        void addBoard(uint8_t address, uint16_t frequencyHz);
+        //Board of an output, NULL when it does not exist or did not initialize
+        Board* boardOf(uint8_t outNum);
+        void setChannel(Board* board, uint8_t channel, uint16_t on, uint16_t off);
+        void setPin(Board* board, uint8_t channel, uint16_t onTicks);
+        void setTimeout(Board* board, uint8_t channel, uint16_t durationMilliseconds);
+        void flushBoard(Board* board);
     };
-}
\ No newline at end of file
+}
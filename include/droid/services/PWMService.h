@@ -15,7 +15,9 @@ namespace droid::services {
     class PWMService : public droid::core::BaseComponent {
     public:
         PWMService(const char* name, droid::core::System* system) :
-            droid::core::BaseComponent(name, system) {}
+            droid::core::BaseComponent(name, system) {
+            setSchedule(SCHEDULE_NORMAL_PERIOD_US, 0, SCHEDULE_PRIORITY_NORMAL);
+        }
 
         //Virtual methods from BaseComponent redeclared here for clarity
         virtual void init() = 0;
@@ -24,6 +26,7 @@ namespace droid::services {
         virtual void logConfig() = 0;
         virtual void failsafe() = 0;
         
+        //Outputs may only be updated by the next task(), every output set since the last one goes out together
         virtual void setPWMuS(uint8_t outNum, uint16_t pulseMicroseconds, uint16_t durationMilliseconds = 0) = 0;
         virtual void setPWMpercent(uint8_t outNum, uint8_t percent, uint16_t durationMilliseconds = 0) = 0;
     };
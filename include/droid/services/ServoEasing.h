@@ -0,0 +1,72 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use.
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <Arduino.h>
+
+namespace droid::services {
+    /**
+     * @brief Easing curves for servo moves.  A move from one pulse width to another
+     * is spread over a duration and interpolate() gives the pulse width for the time
+     * elapsed, so the servo is stepped a little each tick instead of being sent
+     * straight to its end position at full current.
+     */
+    class ServoEasing {
+    public:
+        enum Curve {
+            NONE,           //jump straight to the end position (the old behavior)
+            LINEAR,         //constant speed
+            CUBIC,          //accelerate through the first half, decelerate through the second
+            BOUNCE};        //settle onto the end position with a few shrinking bounces
+
+        static uint16_t interpolate(Curve curve, uint16_t fromMicroSeconds, uint16_t toMicroSeconds, uint32_t elapsedMs, uint32_t durationMs) {
+            if ((curve == NONE) || (elapsedMs >= durationMs)) {
+                return toMicroSeconds;
+            }
+            float progress = ease(curve, (float) elapsedMs / durationMs);
+            return fromMicroSeconds + (int32_t) ((toMicroSeconds - fromMicroSeconds) * progress);
+        }
+
+        //Fraction of the move done at time t (both 0 to 1)
+        static float ease(Curve curve, float t) {
+            switch (curve) {
+                case CUBIC:
+                    if (t < 0.5f) {
+                        return 4.0f * t * t * t;
+                    } else {
+                        float u = (2.0f * t) - 2.0f;
+                        return 1.0f + (0.5f * u * u * u);
+                    }
+
+                case BOUNCE:
+                    //Ease-out bounce, the bounces stay short of the end position
+                    if (t < (1.0f / 2.75f)) {
+                        return 7.5625f * t * t;
+                    } else if (t < (2.0f / 2.75f)) {
+                        t -= 1.5f / 2.75f;
+                        return (7.5625f * t * t) + 0.75f;
+                    } else if (t < (2.5f / 2.75f)) {
+                        t -= 2.25f / 2.75f;
+                        return (7.5625f * t * t) + 0.9375f;
+                    } else {
+                        t -= 2.625f / 2.75f;
+                        return (7.5625f * t * t) + 0.984375f;
+                    }
+
+                case LINEAR:
+                    return t;
+
+                case NONE:
+                default:
+                    return 1.0f;
+            }
+        }
+    };
+}
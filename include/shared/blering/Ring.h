@@ -52,5 +52,6 @@ namespace blering {
         MagicseeR1 *otherRing = nullptr;
         uint32_t droppedReports = 0;
         bool L2wasPressed = false;
+        LogRateLimit stateLimit{LOGGER_LIMIT_TICK_MS, LOGGER_LIMIT_TICK_BURST};    //printState() while driving
     };
 }
\ No newline at end of file
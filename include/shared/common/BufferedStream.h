@@ -1,7 +1,24 @@
 #pragma once
 #include <Arduino.h>
+#include <mutex>
 
+/**
+ * @brief Stream that queues its output in a ring buffer and writes it to the
+ * wrapped serial port only as fast as the port's TX buffer accepts it, so a
+ * burst of output never waits on the baud rate.  Writes are copied into the
+ * ring in at most two memcpy segments and task() drains it in chunks of
+ * availableForWrite() bytes.  What happens when the ring is full is set by
+ * the OverflowPolicy, the bytes lost are counted.  Writers and task() may
+ * run on different tasks.
+ */
 class BufferedStream : public Stream {
+public:
+    enum OverflowPolicy {
+        DROP_NEWEST,    //Discard what does not fit of the new write
+        DROP_OLDEST,    //Discard the oldest buffered bytes to make room
+        BLOCK};         //Wait for the serial port to take the oldest bytes (the old behavior),
+                        //  what still does not fit when the port stops taking bytes is dropped
+
 private:
     HardwareSerial* wrapped = nullptr;
     uint8_t* buffer = nullptr;
@@ -9,32 +26,61 @@ private:
     size_t writeIndex = 0;
     size_t readIndex = 0;
     size_t totalSize = 0;
+    OverflowPolicy policy = DROP_OLDEST;
+    unsigned long droppedBytes = 0;
+    size_t highWater = 0;           //Most bytes ever buffered at once
+    std::mutex lock;                //guards the ring
+
+    size_t freeSpace() {
+        return bufferSize - totalSize;
+    }
 
-    virtual bool isEmpty() {
-        return (totalSize == 0);
+    //Bytes that can be read from readIndex without wrapping
+    size_t readSegment() {
+        return min(totalSize, bufferSize - readIndex);
     }
 
-    virtual bool isFull() {
-        return (totalSize == bufferSize);
+    void append(const uint8_t* data, size_t size) {
+        size_t first = min(size, bufferSize - writeIndex);
+        memcpy(&buffer[writeIndex], data, first);
+        memcpy(buffer, data + first, size - first);
+        writeIndex = (writeIndex + size) % bufferSize;
+        totalSize += size;
+        if (totalSize > highWater) {
+            highWater = totalSize;
+        }
     }
 
-    virtual void append(uint8_t c) {
-        buffer[writeIndex] = c;
-        writeIndex = (writeIndex + 1) % bufferSize;
-        totalSize++;
+    void consume(size_t size) {
+        readIndex = (readIndex + size) % bufferSize;
+        totalSize -= size;
     }
 
-    virtual uint8_t getNext() {
-        uint8_t result = buffer[readIndex];
-        readIndex = (readIndex + 1) % bufferSize;
-        totalSize--;
-        return result;
+    //Write out up to maxSize buffered bytes, without blocking unless block is set
+    void drain(size_t maxSize, bool block) {
+        while ((totalSize > 0) && (maxSize > 0)) {
+            size_t chunk = min(readSegment(), maxSize);
+            if (!block) {
+                int room = wrapped->availableForWrite();
+                if (room <= 0) {
+                    return;
+                }
+                chunk = min(chunk, (size_t) room);
+            }
+            size_t written = wrapped->write(&buffer[readIndex], chunk);
+            if (written == 0) {
+                return;
+            }
+            consume(written);
+            maxSize -= written;
+        }
     }
 
 public:
-    BufferedStream(HardwareSerial* hwSerial, size_t bufSize = 1024) : 
+    BufferedStream(HardwareSerial* hwSerial, size_t bufSize = 1024, OverflowPolicy policy = DROP_OLDEST) :
         wrapped(hwSerial),
-        bufferSize(bufSize) {
+        bufferSize(bufSize),
+        policy(policy) {
 
         buffer = new uint8_t[bufSize];
     }
@@ -44,23 +90,80 @@ public:
     }
 
     virtual size_t write(uint8_t c) override {
-        if (isEmpty() &&
-            wrapped->availableForWrite()) {
-            //No need to buffer, write directly to the stream
-            return wrapped->write(c);
-        } else if (isFull()) {
-            //Do a blocking write to free up a char in the buffer
-            wrapped->write(getNext());
+        return write(&c, 1);
+    }
+
+    virtual size_t write(const uint8_t* data, size_t size) override {
+        std::lock_guard<std::mutex> guard(lock);
+        size_t accepted = 0;
+        if (totalSize == 0) {
+            //Nothing queued, send what the serial port can take right away
+            int room = wrapped->availableForWrite();
+            if (room > 0) {
+                accepted = wrapped->write(data, min(size, (size_t) room));
+                data += accepted;
+                size -= accepted;
+            }
         }
-        //Write into the buffer
-        append(c);
-        return 1;
+        if (size > freeSpace()) {
+            switch (policy) {
+                case DROP_NEWEST: {
+                    size_t dropped = size - freeSpace();
+                    droppedBytes += dropped;
+                    size -= dropped;
+                    break;
+                }
+                case DROP_OLDEST: {
+                    if (size > bufferSize) {
+                        //Only the tail of the write fits in the whole buffer
+                        droppedBytes += size - bufferSize;
+                        accepted += size - bufferSize;
+                        data += size - bufferSize;
+                        size = bufferSize;
+                    }
+                    size_t dropped = size - freeSpace();
+                    droppedBytes += dropped;
+                    consume(dropped);
+                    break;
+                }
+                case BLOCK:
+                    if (size > bufferSize) {
+                        //The head of the write goes straight out once the queued bytes are gone
+                        drain(totalSize, true);
+                        if (totalSize == 0) {
+                            size_t written = wrapped->write(data, size - bufferSize);
+                            accepted += written;
+                            data += written;
+                            size -= written;
+                        }
+                    }
+                    drain(size - freeSpace(), true);
+                    if (size > freeSpace()) {
+                        //The serial port stopped taking bytes, drop the newest as DROP_NEWEST does
+                        size_t dropped = size - freeSpace();
+                        droppedBytes += dropped;
+                        size -= dropped;
+                    }
+                    break;
+            }
+        }
+        append(data, size);
+        return accepted + size;
     }
 
+    using Print::write;
+
     void task() {
-        while (!isEmpty() && wrapped->availableForWrite()) {
-            wrapped->write(getNext());
-        }
+        std::lock_guard<std::mutex> guard(lock);
+        drain(totalSize, false);
+    }
+
+    unsigned long getDroppedBytes() {
+        return droppedBytes;
+    }
+
+    size_t getHighWater() {
+        return highWater;
     }
 
     virtual int available() override {
@@ -76,6 +179,10 @@ public:
     }
 
     virtual void flush() override {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            drain(totalSize, true);
+        }
         wrapped->flush();
     }
 };
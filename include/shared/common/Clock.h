@@ -0,0 +1,62 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use.
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @brief Source of time for the droid.
+ * Components read the time through the Clock held by System rather than
+ * calling millis()/micros() directly, so that time can be replaced with a
+ * VirtualClock for deterministic replay or accelerated simulation.
+ * Both values wrap in the same way as their Arduino counterparts.
+ */
+class Clock {
+public:
+    virtual ~Clock() {}
+    virtual unsigned long millis() = 0;
+    virtual unsigned long micros() = 0;
+
+    /**
+     * @brief true when this Clock follows wall-clock time.  Code that sleeps
+     * or blocks on real time (e.g. FreeRTOS tasks) must not be used with a
+     * Clock that does not.
+     */
+    virtual bool isRealTime() {return true;}
+};
+
+class RealClock : public Clock {
+public:
+    unsigned long millis() override {return ::millis();}
+    unsigned long micros() override {return ::micros();}
+};
+
+/**
+ * @brief Clock that only moves when told to.
+ * Not thread safe, it is intended to be advanced from the same thread that
+ * runs the components reading it.
+ */
+class VirtualClock : public Clock {
+public:
+    VirtualClock(uint64_t startMicros = 0) :
+        nowMicros(startMicros) {}
+
+    unsigned long millis() override {return (unsigned long) (nowMicros / 1000);}
+    unsigned long micros() override {return (unsigned long) nowMicros;}
+    bool isRealTime() override {return false;}
+
+    void advanceMicros(uint32_t deltaMicros) {nowMicros += deltaMicros;}
+    void advanceMillis(uint32_t deltaMillis) {nowMicros += (uint64_t) deltaMillis * 1000;}
+    void setMicros(uint64_t micros) {nowMicros = micros;}
+    uint64_t getMicros() const {return nowMicros;}
+
+private:
+    uint64_t nowMicros = 0;
+};
@@ -10,119 +10,580 @@
 
 #pragma once
 #include <Preferences.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "shared/common/Clock.h"
 #include "shared/common/Logger.h"
 #include "settings/hardware.config.h"
 
+#define CONFIG_SCHEMA_KEY       "_schema"
+#define CONFIG_SCHEMA_STRINGS   1   //Every value stored as a string
+#define CONFIG_SCHEMA_VERSION   2   //Numbers stored as i32, bools as u8, floats as 4 byte blobs
+
+/**
+ * @brief Receives the changes to a subscribed Config namespace or key.
+ * configChanged() is only called from Config::dispatch(), which the owner of
+ * the listener runs on its own thread between two of its tasks, so the new
+ * values can be reloaded without locking and are all applied at once.
+ * key is NULL for a subscription to a whole namespace.
+ */
+class ConfigListener {
+public:
+    virtual void configChanged(const char* nspace, const char* key) = 0;
+};
+
+/**
+ * @brief Component configuration, persisted in the NVS config partition.
+ * Values keep their type (int, bool, float or String) in RAM and in NVS, so
+ * reading a number never parses a string.  Reads are served from an in-RAM
+ * cache, each key is only read from flash the first time it is used.  Writes
+ * only update the cache and mark the key dirty, a low priority writer task
+ * writes them once they have settled for CONFIG_WRITE_DEBOUNCE_MS, so repeated
+ * changes to a key cost one flash write and no caller ever waits on flash.
+ * flush() writes everything immediately (before a restart).  Shared by the
+ * control task and the main loop.
+ *
+ * Listeners can subscribe to a namespace (or a single key of it), changes are
+ * delivered by dispatch() on the listener's own thread, see ConfigListener.
+ */
 class Config {
 public:
-    Config(const char* name, Logger* logger) :
+    Config(const char* name, Logger* logger, Clock* clock) :
         name(name),
-        logger(logger) {}
+        logger(logger),
+        clock(clock) {}
+
+    /**
+     * @brief Start the writer task.  When the Clock is not real time, or the task
+     * cannot be created, changes are written from poll() instead.
+     */
+    bool start(uint8_t core, uint8_t priority, uint32_t stackSize) {
+        if (!clock->isRealTime()) {
+            return false;
+        }
+        writerRunning = (xTaskCreatePinnedToCore(writerEntry, name, stackSize, this, priority, NULL, core) == pdPASS);
+        if (!writerRunning) {
+            logger->log(name, WARN, "Unable to start Config writer task, writing from the main loop\n");
+        }
+        return writerRunning;
+    }
+
+    //Only used when the writer task is not running
+    void poll() {
+        if (!writerRunning) {
+            writeSettled();
+        }
+    }
+
+    /**
+     * @brief Call listener->configChanged() from dispatch() when the key (or any key of
+     * the namespace if key is NULL) changes.  As for BaseComponent names, nspace and
+     * key are not copied and must remain valid for the life of the program.
+     */
+    void subscribe(const char* nspace, const char* key, ConfigListener* listener) {
+        std::lock_guard<std::mutex> guard(lock);
+        Subscription subscription;
+        subscription.nspace = nspace;
+        subscription.key = key;
+        subscription.listener = listener;
+        subscriptions.push_back(subscription);
+    }
+
+    //Incremented whenever a subscription has a change waiting to be dispatched
+    uint32_t getChangeCount() const {
+        return changeCount.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Deliver the changes waiting for this listener.  Each subscription is
+     * notified once, however many times its values changed since the last dispatch.
+     */
+    void dispatch(ConfigListener* listener) {
+        for (size_t index = 0; ; index++) {
+            Subscription subscription;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (index >= subscriptions.size()) {
+                    return;
+                }
+                if ((subscriptions[index].listener != listener) || !subscriptions[index].pending) {
+                    continue;
+                }
+                subscriptions[index].pending = false;
+                subscription = subscriptions[index];
+            }
+            //Called without the lock, the listener will read its new values
+            listener->configChanged(subscription.nspace, subscription.key);
+        }
+    }
 
     void putInt(const char* nspace, const char* key, int value) {
-        char buf[20];
-        snprintf(buf, sizeof(buf), "%d", value);
-        putString(nspace, key, buf);
+        std::unique_lock<std::mutex> guard(lock);
+        putNumber(guard, nspace, key, CONFIG_TYPE_INT, value, 0.0f);
     }
 
     int getInt(const char* nspace, const char* key, int defaultValue) {
-        int value = defaultValue;
-        char defaultStr[20];
-        snprintf(defaultStr, sizeof(defaultStr), "%d", defaultValue);
-        String configValue = getString(nspace, key, defaultStr);
-        const char* cValue = configValue.c_str();
-        char* endPtr;
-        value = strtol(cValue, &endPtr, 10);
-        if ((endPtr == cValue) || (*endPtr != '\0')) {   //parse error
-            logger->log(name, WARN, "Parse ERROR in Config.getInt(%s, %s, %d) value from store: '%s'\n", nspace, key, defaultValue, cValue);
-            value = defaultValue;
+        std::unique_lock<std::mutex> guard(lock);
+        ConfigEntry* entry = getNumber(guard, nspace, key, CONFIG_TYPE_INT);
+        if (entry == nullptr) {
+            return defaultValue;
         }
-        return value;
+        return (entry->type == CONFIG_TYPE_FLOAT) ? (int) entry->floatValue : entry->intValue;
     }
 
     void putBool(const char* nspace, const char* key, bool value) {
-        char buf[20];
-        snprintf(buf, sizeof(buf), "%d", value);
-        putString(nspace, key, buf);
+        std::unique_lock<std::mutex> guard(lock);
+        putNumber(guard, nspace, key, CONFIG_TYPE_BOOL, value ? 1 : 0, 0.0f);
     }
 
     bool getBool(const char* nspace, const char* key, bool defaultValue) {
-        bool value = defaultValue;
-        char defaultStr[20];
-        snprintf(defaultStr, sizeof(defaultStr), "%d", defaultValue);
-        String configValue = getString(nspace, key, defaultStr);
-        const char* cValue = configValue.c_str();
-        char* endPtr;
-        value = (bool) strtol(cValue, &endPtr, 10);
-        if ((endPtr == cValue) || (*endPtr != '\0')) {   //parse error
-            logger->log(name, WARN, "Parse ERROR in Config.getBool(%s, %s, %d) value from store: '%s'\n", nspace, key, defaultValue, cValue);
-            value = defaultValue;
+        std::unique_lock<std::mutex> guard(lock);
+        ConfigEntry* entry = getNumber(guard, nspace, key, CONFIG_TYPE_BOOL);
+        if (entry == nullptr) {
+            return defaultValue;
         }
-        return value;
+        return (entry->type == CONFIG_TYPE_FLOAT) ? (bool) entry->floatValue : (bool) entry->intValue;
     }
 
     void putFloat(const char* nspace, const char* key, float value) {
-        char buf[20];
-        snprintf(buf, sizeof(buf), "%.3f", value);
-        putString(nspace, key, buf);
+        std::unique_lock<std::mutex> guard(lock);
+        putNumber(guard, nspace, key, CONFIG_TYPE_FLOAT, 0, value);
     }
 
     float getFloat(const char* nspace, const char* key, float defaultValue) {
-        float value = defaultValue;
-        char defaultStr[20];
-        snprintf(defaultStr, sizeof(defaultStr), "%.3f", defaultValue);
-        String configValue = getString(nspace, key, defaultStr);
-        const char* cValue = configValue.c_str();
-        char* endPtr;
-        value = strtof(cValue, &endPtr);
-        if ((endPtr == cValue) || (*endPtr != '\0')) {   //parse error
-            logger->log(name, WARN, "Parse ERROR in Config.getFloat(%s, %s, %.3f) value from store: '%s'\n", nspace, key, defaultValue, cValue);
-            value = defaultValue;
+        std::unique_lock<std::mutex> guard(lock);
+        ConfigEntry* entry = getNumber(guard, nspace, key, CONFIG_TYPE_FLOAT);
+        if (entry == nullptr) {
+            return defaultValue;
         }
-        return value;
+        return (entry->type == CONFIG_TYPE_FLOAT) ? entry->floatValue : (float) entry->intValue;
     }
 
+    /**
+     * @brief Store a String value.  When the key already holds a number (e.g. SetConfig
+     * from the console) the value is parsed once here and kept as that type.
+     */
     void putString(const char* nspace, const char* key, const char* value) {
-        if (preferences.begin(nspace, false, CONFIG_PARTITION_NAME)) {
-            preferences.putString(key, value);
-            preferences.end();
+        std::unique_lock<std::mutex> guard(lock);
+        ConfigEntry* entry = getEntry(guard, nspace, key, true);
+        if (entry->exists && (entry->type != CONFIG_TYPE_STRING)) {
+            ConfigType type = entry->type;
+            String previous = entry->value;
+            entry->value = value;
+            if (parse(entry, type)) {
+                entry->value = "";
+                entry->dirty = true;
+                changed();
+                notify(nspace, key);
+                return;
+            }
+            entry->value = previous;
+        }
+        if (entry->exists && (entry->type == CONFIG_TYPE_STRING) && (entry->value == value)) {
+            return;
         }
+        entry->type = CONFIG_TYPE_STRING;
+        entry->value = value;
+        entry->exists = true;
+        entry->dirty = true;
+        changed();
+        notify(nspace, key);
     }
 
     String getString(const char* nspace, const char* key, const char* defaultValue) {
-        String value = defaultValue;
-        if (preferences.begin(nspace, true, CONFIG_PARTITION_NAME)) {
-            value = preferences.getString(key, defaultValue);
-            preferences.end();
+        std::unique_lock<std::mutex> guard(lock);
+        ConfigEntry* entry = getEntry(guard, nspace, key, true);
+        if (!entry->exists) {
+            return String(defaultValue);
+        }
+        char buf[20];
+        switch (entry->type) {
+            case CONFIG_TYPE_INT:
+            case CONFIG_TYPE_BOOL:
+                snprintf(buf, sizeof(buf), "%d", (int) entry->intValue);
+                return String(buf);
+            case CONFIG_TYPE_FLOAT:
+                snprintf(buf, sizeof(buf), "%.3f", entry->floatValue);
+                return String(buf);
+            default:
+                return entry->value;
         }
-        return value;
     }
 
     void clear(const char* nspace) {
-        if (preferences.begin(nspace, false, CONFIG_PARTITION_NAME)) {
-            preferences.clear();
-            preferences.end();
-        }
+        std::unique_lock<std::mutex> guard(lock);
+        ConfigNamespace* configNamespace = getNamespace(guard, nspace);
+        configNamespace->entries.clear();
+        //Every key of the namespace is now in RAM, the store does not need to be read again
+        configNamespace->complete = true;
+        configNamespace->pendingClear = true;
+        changed();
+        notify(nspace, NULL);
     }
 
     void remove(const char* nspace, const char* key) {
-        if (preferences.begin(nspace, false, CONFIG_PARTITION_NAME)) {
-            preferences.remove(key);
-            preferences.end();
+        std::unique_lock<std::mutex> guard(lock);
+        ConfigEntry* entry = getEntry(guard, nspace, key, true);
+        if (entry->exists) {
+            entry->value = "";
+            entry->type = CONFIG_TYPE_STRING;
+            entry->exists = false;
+            entry->dirty = true;
+            changed();
+            notify(nspace, key);
         }
     }
 
     bool isKey(const char* nspace, const char* key) {
-        bool isKey = false;
-        if (preferences.begin(nspace, false, CONFIG_PARTITION_NAME)) {
-            isKey = preferences.isKey(key);
+        std::unique_lock<std::mutex> guard(lock);
+        return getEntry(guard, nspace, key, true)->exists;
+    }
+
+    /**
+     * @brief Write all pending changes to the store now.
+     * The changes are collected under the cache lock, then written without
+     * holding it, opening each namespace only once.
+     */
+    void flush() {
+        if (!dirty) {
+            return;
+        }
+        //Flushes are serialized so an older batch can never be written over a newer one
+        std::lock_guard<std::mutex> flushGuard(flushLock);
+        std::vector<PendingNamespace> pending;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (ConfigNamespace& configNamespace : namespaces) {
+                PendingNamespace* pendingNamespace = nullptr;
+                if (configNamespace.pendingClear) {
+                    pending.emplace_back();
+                    pendingNamespace = &pending.back();
+                    pendingNamespace->name = configNamespace.name;
+                    pendingNamespace->clear = true;
+                    configNamespace.pendingClear = false;
+                }
+                for (ConfigEntry& entry : configNamespace.entries) {
+                    if (entry.dirty) {
+                        if (pendingNamespace == nullptr) {
+                            pending.emplace_back();
+                            pendingNamespace = &pending.back();
+                            pendingNamespace->name = configNamespace.name;
+                        }
+                        pendingNamespace->entries.push_back(entry);
+                        entry.storedType = entry.exists ? entry.type : CONFIG_TYPE_NONE;
+                        entry.dirty = false;
+                    }
+                }
+                if ((pendingNamespace != nullptr) && (configNamespace.schema != CONFIG_SCHEMA_VERSION)) {
+                    pendingNamespace->writeSchema = true;
+                    configNamespace.schema = CONFIG_SCHEMA_VERSION;
+                }
+            }
+            dirty = false;
+        }
+
+        std::lock_guard<std::mutex> guard(storeLock);
+        for (PendingNamespace& pendingNamespace : pending) {
+            if (!preferences.begin(pendingNamespace.name.c_str(), false, CONFIG_PARTITION_NAME)) {
+                logger->log(name, ERROR, "Unable to open config namespace %s for writing\n", pendingNamespace.name.c_str());
+                continue;
+            }
+            if (pendingNamespace.clear) {
+                preferences.clear();
+            }
+            if (pendingNamespace.writeSchema || pendingNamespace.clear) {
+                preferences.putUChar(CONFIG_SCHEMA_KEY, CONFIG_SCHEMA_VERSION);
+            }
+            for (const ConfigEntry& entry : pendingNamespace.entries) {
+                if (!entry.exists ||
+                    (entry.storedType == CONFIG_TYPE_UNKNOWN) ||
+                    ((entry.storedType != CONFIG_TYPE_NONE) && (entry.storedType != entry.type))) {
+                    //NVS keeps one value per key and type, drop the old one when the type changes
+                    //  (or may have, the key was written without reading the store first)
+                    preferences.remove(entry.key.c_str());
+                }
+                if (entry.exists) {
+                    switch (entry.type) {
+                        case CONFIG_TYPE_INT:   preferences.putInt(entry.key.c_str(), entry.intValue); break;
+                        case CONFIG_TYPE_BOOL:  preferences.putBool(entry.key.c_str(), entry.intValue != 0); break;
+                        case CONFIG_TYPE_FLOAT: preferences.putFloat(entry.key.c_str(), entry.floatValue); break;
+                        default:                preferences.putString(entry.key.c_str(), entry.value); break;
+                    }
+                }
+            }
             preferences.end();
         }
-        return isKey;
     }
 
 private:
+    //How a value is held in RAM and in NVS (i32, u8, 4 byte blob or string)
+    enum ConfigType : uint8_t {
+        CONFIG_TYPE_NONE, CONFIG_TYPE_STRING, CONFIG_TYPE_INT, CONFIG_TYPE_BOOL, CONFIG_TYPE_FLOAT,
+        CONFIG_TYPE_UNKNOWN};       //storedType only, the store was not read for the key
+
+    struct ConfigEntry {
+        String key;
+        String value;               //Only used by CONFIG_TYPE_STRING
+        int32_t intValue = 0;       //CONFIG_TYPE_INT and CONFIG_TYPE_BOOL
+        float floatValue = 0.0f;    //CONFIG_TYPE_FLOAT
+        ConfigType type = CONFIG_TYPE_STRING;
+        ConfigType storedType = CONFIG_TYPE_NONE;   //Type of the value currently in the store
+        bool exists = false;        //false if the key is not in the store (or was removed)
+        bool dirty = false;         //changed since the last flush()
+    };
+
+    struct ConfigNamespace {
+        String name;
+        std::vector<ConfigEntry> entries;   //sorted by key
+        uint8_t schema = CONFIG_SCHEMA_VERSION;
+        bool complete = false;      //true when every key of the namespace is in entries
+        bool pendingClear = false;  //clear() has not been written to the store yet
+    };
+
+    struct Subscription {
+        const char* nspace = nullptr;
+        const char* key = nullptr;      //NULL for every key of the namespace
+        ConfigListener* listener = nullptr;
+        bool pending = false;           //changed since the last dispatch()
+    };
+
+    //Changes taken from the cache by flush(), to be written to the store
+    struct PendingNamespace {
+        String name;
+        bool clear = false;
+        bool writeSchema = false;
+        std::vector<ConfigEntry> entries;
+    };
+
     Preferences preferences;
     const char* name = nullptr;
     Logger* logger = nullptr;
+    Clock* clock = nullptr;
+    std::mutex lock;                //guards the cache
+    std::mutex storeLock;           //guards preferences, never taken before lock
+    std::mutex flushLock;           //held for a whole flush(), taken before the others
+    std::vector<ConfigNamespace> namespaces;
+    std::vector<Subscription> subscriptions;
+    std::atomic<uint32_t> changeCount{0};
+    volatile bool dirty = false;
+    volatile bool writerRunning = false;
+    unsigned long firstChangeTime = 0;
+    unsigned long lastChangeTime = 0;
+
+    //Called with the cache locked
+    void changed() {
+        lastChangeTime = clock->millis();
+        if (!dirty) {
+            firstChangeTime = lastChangeTime;
+            dirty = true;
+        }
+    }
+
+    void writeSettled() {
+        if (!dirty) {
+            return;
+        }
+        unsigned long now = clock->millis();
+        if (((now - lastChangeTime) >= CONFIG_WRITE_DEBOUNCE_MS) ||
+            ((now - firstChangeTime) >= CONFIG_WRITE_MAX_DELAY_MS)) {
+            flush();
+        }
+    }
+
+    static void writerEntry(void* param) {
+        Config* config = (Config*) param;
+        while (true) {
+            vTaskDelay(pdMS_TO_TICKS(CONFIG_WRITER_PERIOD_MS));
+            config->writeSettled();
+        }
+    }
+
+    ConfigNamespace* findNamespace(const char* nspace) {
+        for (ConfigNamespace& configNamespace : namespaces) {
+            if (strcmp(configNamespace.name.c_str(), nspace) == 0) {
+                return &configNamespace;
+            }
+        }
+        return nullptr;
+    }
+
+    //The store is read with the cache unlocked (guard holds lock), a flush may hold storeLock
+    //  for a while and readers of cached keys must not wait on it
+    ConfigNamespace* getNamespace(std::unique_lock<std::mutex>& guard, const char* nspace) {
+        ConfigNamespace* configNamespace = findNamespace(nspace);
+        if (configNamespace != nullptr) {
+            return configNamespace;
+        }
+        //Namespaces written before the schema key was introduced hold every value as a string
+        uint8_t schema = CONFIG_SCHEMA_VERSION;
+        guard.unlock();
+        {
+            std::lock_guard<std::mutex> storeGuard(storeLock);
+            if (preferences.begin(nspace, true, CONFIG_PARTITION_NAME)) {
+                schema = preferences.getUChar(CONFIG_SCHEMA_KEY, CONFIG_SCHEMA_STRINGS);
+                preferences.end();
+            }
+        }
+        guard.lock();
+        configNamespace = findNamespace(nspace);
+        if (configNamespace != nullptr) {
+            return configNamespace;     //Added by another task meanwhile
+        }
+        namespaces.emplace_back();
+        configNamespace = &namespaces.back();
+        configNamespace->name = nspace;
+        configNamespace->schema = schema;
+        if (configNamespace->schema > CONFIG_SCHEMA_VERSION) {
+            logger->log(name, WARN, "Config namespace %s has unknown schema %d\n", nspace, configNamespace->schema);
+        }
+        return configNamespace;
+    }
+
+    ConfigEntry* findEntry(ConfigNamespace* configNamespace, const char* key, std::vector<ConfigEntry>::iterator& it) {
+        std::vector<ConfigEntry>& entries = configNamespace->entries;
+        it = std::lower_bound(entries.begin(), entries.end(), key,
+            [](const ConfigEntry& entry, const char* key) {return strcmp(entry.key.c_str(), key) < 0;});
+        if ((it != entries.end()) && (strcmp(it->key.c_str(), key) == 0)) {
+            return &(*it);
+        }
+        return nullptr;
+    }
+
+    //Returns the cached entry for the key, the store is only read the first time a key is used.
+    //  As in getNamespace() the read is made with the cache unlocked.
+    ConfigEntry* getEntry(std::unique_lock<std::mutex>& guard, const char* nspace, const char* key, bool load) {
+        ConfigNamespace* configNamespace = getNamespace(guard, nspace);
+        std::vector<ConfigEntry>::iterator it;
+        ConfigEntry* cached = findEntry(configNamespace, key, it);
+        if (cached != nullptr) {
+            return cached;
+        }
+        ConfigEntry entry;
+        entry.key = key;
+        if (load && !configNamespace->complete) {
+            guard.unlock();
+            readEntry(nspace, key, entry);
+            guard.lock();
+            //namespaces may have grown and the entries moved, look both up again
+            configNamespace = getNamespace(guard, nspace);
+            cached = findEntry(configNamespace, key, it);
+            if (cached != nullptr) {
+                return cached;      //Read or written by another task meanwhile, that one is newer
+            }
+            if (configNamespace->complete) {
+                //Cleared meanwhile, what was read is gone
+                entry = ConfigEntry();
+                entry.key = key;
+            }
+        } else if (!configNamespace->complete) {
+            //Whatever the store holds for the key is not known, flush() removes it before writing
+            entry.storedType = CONFIG_TYPE_UNKNOWN;
+        }
+        return &(*configNamespace->entries.insert(it, entry));
+    }
+
+    //Reads the stored value of a key into entry, without the cache lock
+    void readEntry(const char* nspace, const char* key, ConfigEntry& entry) {
+        std::lock_guard<std::mutex> storeGuard(storeLock);
+        if (preferences.begin(nspace, true, CONFIG_PARTITION_NAME)) {
+            entry.exists = true;
+            switch (preferences.getType(key)) {
+                case PT_STR:
+                    entry.type = CONFIG_TYPE_STRING;
+                    entry.value = preferences.getString(key, "");
+                    break;
+                case PT_I32:
+                    entry.type = CONFIG_TYPE_INT;
+                    entry.intValue = preferences.getInt(key, 0);
+                    break;
+                case PT_U8:
+                    entry.type = CONFIG_TYPE_BOOL;
+                    entry.intValue = preferences.getUChar(key, 0);
+                    break;
+                case PT_BLOB:
+                    entry.type = CONFIG_TYPE_FLOAT;
+                    entry.exists = (preferences.getBytes(key, &entry.floatValue, sizeof(entry.floatValue)) == sizeof(entry.floatValue));
+                    break;
+                default:
+                    entry.exists = false;
+            }
+            entry.storedType = entry.exists ? entry.type : CONFIG_TYPE_NONE;
+            preferences.end();
+        }
+    }
+
+    //Returns the entry holding a number, or nullptr if there is none.  Values still
+    //  stored as strings (schema 1, or SetConfig of a new key) are parsed once and
+    //  rewritten with their native type.
+    ConfigEntry* getNumber(std::unique_lock<std::mutex>& guard, const char* nspace, const char* key, ConfigType type) {
+        ConfigEntry* entry = getEntry(guard, nspace, key, true);
+        if (!entry->exists) {
+            return nullptr;
+        }
+        if (entry->type == CONFIG_TYPE_STRING) {
+            if (!parse(entry, type)) {
+                logger->log(name, WARN, "Parse ERROR in Config(%s, %s) value from store: '%s'\n", nspace, key, entry->value.c_str());
+                return nullptr;
+            }
+            entry->value = "";
+            entry->dirty = true;
+            changed();
+        }
+        return entry;
+    }
+
+    //Convert the string in entry->value to type, the entry is unchanged if it is not a valid number
+    bool parse(ConfigEntry* entry, ConfigType type) {
+        const char* cValue = entry->value.c_str();
+        char* endPtr;
+        if (type == CONFIG_TYPE_FLOAT) {
+            float value = strtof(cValue, &endPtr);
+            if ((endPtr == cValue) || (*endPtr != '\0')) {
+                return false;
+            }
+            entry->floatValue = value;
+        } else {
+            long value = strtol(cValue, &endPtr, 10);
+            if ((endPtr == cValue) || (*endPtr != '\0')) {
+                return false;
+            }
+            entry->intValue = (type == CONFIG_TYPE_BOOL) ? (value != 0) : value;
+        }
+        entry->type = type;
+        return true;
+    }
+
+    void putNumber(std::unique_lock<std::mutex>& guard, const char* nspace, const char* key, ConfigType type, int32_t intValue, float floatValue) {
+        ConfigEntry* entry = getEntry(guard, nspace, key, false);
+        if (entry->exists && (entry->type == type) && (entry->intValue == intValue) && (entry->floatValue == floatValue)) {
+            return;
+        }
+        entry->type = type;
+        entry->value = "";
+        entry->intValue = intValue;
+        entry->floatValue = floatValue;
+        entry->exists = true;
+        entry->dirty = true;
+        changed();
+        notify(nspace, key);
+    }
+
+    //Mark the subscriptions to this key (every key of the namespace if key is NULL) as pending
+    void notify(const char* nspace, const char* key) {
+        bool pending = false;
+        for (Subscription& subscription : subscriptions) {
+            if ((strcmp(subscription.nspace, nspace) == 0) &&
+                ((key == NULL) || (subscription.key == NULL) || (strcmp(subscription.key, key) == 0))) {
+                subscription.pending = true;
+                pending = true;
+            }
+        }
+        if (pending) {
+            changeCount.fetch_add(1, std::memory_order_release);
+        }
+    }
 };
@@ -10,119 +10,702 @@
 
 #pragma once
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include <mutex>
+#include "shared/common/Clock.h"
+#include "settings/hardware.config.h"
 
 #define LOGGER_NAME "Logger"
+#define LOGGER_MAX_IDS          64      //Component names that can have their own log level
+#define LOGGER_NAME_LEN         16
+#define LOGGER_DEFAULT_ID       0       //Id of LOGGER_NAME, holds the default level
+
+//Compile time floor of the LOGGER_LOG call sites of a source file, those below it are
+//  removed from the build (arguments included).  A file selects its own floor by
+//  defining LOGGER_FLOOR before its first #include, see settings/hardware.config.h
+#ifndef LOGGER_FLOOR
+#define LOGGER_FLOOR LOGGER_FLOOR_DEFAULT
+#endif
+
+//Used for DEBUG and INFO messages, WARN and above always go through (they trigger the failsafe).
+//  Below WARN the level is checked inline, a filtered message costs one compare and its
+//  arguments are not evaluated.  The "" in front of the format makes anything but a literal
+//  a compile error, a deferred record only keeps the format pointer.
+#define LOGGER_WANTED(logger, id, level) (((level) >= WARN) || (logger)->isEnabled((id), (level)))
+#define LOGGER_LOG(logger, id, level, ...) \
+    do { if (((level) >= LOGGER_FLOOR) && LOGGER_WANTED((logger), (id), (level))) {(logger)->log((id), (level), "" __VA_ARGS__);} } while (0)
+#define LOGGER_PRINTF(logger, id, level, ...) \
+    do { if (((level) >= LOGGER_FLOOR) && LOGGER_WANTED((logger), (id), (level))) {(logger)->printf((id), (level), "" __VA_ARGS__);} } while (0)
+//For work done only to build a log message
+#define LOGGER_ENABLED(logger, id, level) (((level) >= LOGGER_FLOOR) && (logger)->isEnabled((id), (level)))
+//LOGGER_LOG with a token bucket of its own (burst messages, then one per intervalMs), for call sites
+//  that can repeat every tick.  Messages over the limit are only counted, see Logger::admit()
+#define LOGGER_LOG_LIMITED(logger, id, level, intervalMs, burst, ...) \
+    do { if ((level) >= LOGGER_FLOOR) { \
+        static LogRateLimit logRateLimit((intervalMs), (burst)); \
+        if ((logger)->admit((id), (level), logRateLimit)) {(logger)->log((id), (level), "" __VA_ARGS__);} \
+    } } while (0)
+//For a rate limited group of log() and printf() calls, with a LogRateLimit kept by the caller
+#define LOGGER_ADMIT(logger, id, level, limit) (((level) >= LOGGER_FLOOR) && (logger)->admit((id), (level), (limit)))
+#define LOGGER_MAX_ARGS         8       //Arguments captured per deferred record
+#define LOGGER_RECORD_TEXT_LEN  96      //Room for copies of the %s arguments of a deferred record
 
 enum LogLevel {
         DEBUG, INFO, WARN, ERROR, FATAL};
 
-struct LogConfigEntry {
-public:
-    LogConfigEntry(const char* compName, LogLevel level) :
-        level(level),
-        name(compName),
-        next(NULL) {
-    };
-    LogConfigEntry* next = nullptr;
-    const char* name = nullptr;
+//Interned component name, see Logger::getLogId()
+typedef uint8_t LogId;
+
+//A log() call captured by a deferred Logger, formatted later by the logger task
+struct LogRecord {
+    unsigned long timestamp = 0;
+    const char* compName = nullptr;
+    const char* format = nullptr;       //Must be a literal, only the pointer is kept
     LogLevel level = DEBUG;
+    bool header = true;                 //false for Logger::printf()
+    uint8_t textLen = 0;
+    union {
+        long long i;                    //Every integer conversion (and the offset of a %s copy in text)
+        double d;
+        const void* p;
+    } args[LOGGER_MAX_ARGS];
+    char text[LOGGER_RECORD_TEXT_LEN];
+};
+
+/**
+ * @brief Token bucket of a rate limited log call site: up to burst messages at once,
+ * refilled at one message per intervalMs.  The bucket holds milliseconds of credit
+ * and a message costs intervalMs of it.  Not locked, a call site shared by two tasks
+ * may let an extra message through now and then.
+ */
+struct LogRateLimit {
+    constexpr LogRateLimit(uint32_t intervalMs, uint16_t burst) :
+        intervalMs(intervalMs),
+        capacity(intervalMs * burst),
+        credit(intervalMs * burst) {}
+
+    bool take(unsigned long now) {
+        uint32_t elapsed = min((uint32_t) (now - last), capacity);
+        credit = min(credit + elapsed, capacity);
+        last = now;
+        if (credit >= intervalMs) {
+            credit -= intervalMs;
+            return true;
+        }
+        suppressed++;
+        return false;
+    }
+
+    const uint32_t intervalMs;
+    const uint32_t capacity;
+    uint32_t credit;
+    unsigned long last = 0;
+    unsigned long suppressed = 0;       //Messages refused since the last one let through
 };
 
 class Logger {
 public:
-    Logger(Print* out, LogLevel defaultLevel) :
-        out(out) {
-        logConfigList = new LogConfigEntry(LOGGER_NAME, defaultLevel);
+    Logger(Print* out, LogLevel defaultLevel, Clock* clock = nullptr) :
+        out(out),
+        clock(clock) {
+        snprintf(names[LOGGER_DEFAULT_ID], LOGGER_NAME_LEN, "%s", LOGGER_NAME);
+        levels[LOGGER_DEFAULT_ID] = defaultLevel;
+        explicitLevel[LOGGER_DEFAULT_ID] = true;
+        idCount = 1;
+        for (uint32_t index = 0; index < LOGGER_QUEUE_SIZE; index++) {
+            slots[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Id for a component name (case insensitive), created on first use.
+     * Components look their id up once and pass it to log(), so filtering a
+     * message is a single array lookup instead of a search by name.  Names
+     * without a level of their own follow the default (LOGGER_NAME) level.
+     * LOGGER_DEFAULT_ID is returned once LOGGER_MAX_IDS names are in use.
+     */
+    LogId getLogId(const char* compName) {
+        LogId id = findLogId(compName);
+        if (id != LOGGER_DEFAULT_ID) {
+            return id;
+        }
+        if (strcasecmp(compName, LOGGER_NAME) == 0) {
+            return LOGGER_DEFAULT_ID;
+        }
+        std::lock_guard<std::mutex> guard(idLock);
+        id = findLogId(compName);
+        if ((id == LOGGER_DEFAULT_ID) && (idCount < LOGGER_MAX_IDS)) {
+            id = idCount;
+            snprintf(names[id], LOGGER_NAME_LEN, "%s", compName);
+            levels[id] = levels[LOGGER_DEFAULT_ID];
+            explicitLevel[id] = false;
+            idCount = id + 1;       //Published last, findLogId() reads without the lock
+        }
+        return id;
+    }
+
+    const char* getLogName(LogId id) const {
+        return names[id];
+    }
+
+    bool isEnabled(LogId id, LogLevel level) const {
+        return level >= levels[id];
+    }
+
+    bool isEnabled(const char* compName, LogLevel level) const {
+        return level >= levels[findLogId(compName)];
+    }
+
+    /**
+     * @brief Switch to deferred logging.  log() and printf() then only copy the format
+     * pointer and the raw arguments into a ring of LogRecords, formatting and output
+     * are done by a low priority logger task.  When the Clock is not real time, or the
+     * task cannot be created, the records are written from poll() instead.
+     * Formats must be literals (only the pointer is kept), %s arguments are copied.
+     * Capturing a record takes no lock, so once started the Logger can be used from
+     * BLE/USB callbacks on either core without blocking them.
+     */
+    bool start(uint8_t core, uint8_t priority, uint32_t stackSize) {
+        deferred = true;
+        if (!clock || !clock->isRealTime()) {
+            return false;
+        }
+        taskRunning = (xTaskCreatePinnedToCore(taskEntry, LOGGER_NAME, stackSize, this, priority, NULL, core) == pdPASS);
+        return taskRunning;
+    }
+
+    //Called from the main loop, does the logger task's work when it is not running
+    void poll() {
+        if (!taskRunning) {
+            drain(false);
+        }
+    }
+
+    //Write every deferred record and pending repeat count now (before a restart)
+    void flush() {
+        drain(true);
+    }
+
+    /**
+     * @brief Level check of a rate limited call site, true when its message should be
+     * logged.  The level still counts toward getMaxLevel() when the message is refused,
+     * so a limited ERROR keeps triggering the failsafe.  Tokens are only taken for
+     * messages that pass the level check.  The first message let through after some
+     * were refused is preceded by a count of them.
+     */
+    bool admit(LogId id, LogLevel level, LogRateLimit& limit) {
+        updateLevel(level);
+        if (level < levels[id]) {
+            return false;
+        }
+        if (!limit.take(clock ? clock->millis() : millis())) {
+            return false;
+        }
+        if (limit.suppressed > 0) {
+            log(id, level, "%lu similar messages suppressed\n", limit.suppressed);
+            limit.suppressed = 0;
+        }
+        return true;
+    }
+
+    bool admit(const char* compName, LogLevel level, LogRateLimit& limit) {
+        return admit(findLogId(compName), level, limit);
+    }
+
+    void log(LogId id, LogLevel level, const char *format, ...)  __attribute__ ((format (printf, 4, 5))) {
+        updateLevel(level);
+        if (level < levels[id]) {
+            return;
+        }
+        va_list args; 
+        va_start(args, format); 
+        write(names[id], level, true, format, args);
+        va_end(args);
     }
 
     void log(const char* compName, LogLevel level, const char *format, ...)  __attribute__ ((format (printf, 4, 5))) {
         updateLevel(level);
-        if (out) {
-            if (level >= getLogLevel(compName)) {
-                out->printf("%s : %d : %s : ", levelStr[level], millis(), compName);
-                va_list args; 
-                va_start(args, format); 
-                vsnprintf(buf, sizeof(buf), format, args); 
-                va_end(args);
-                out->print(buf);
-            }
+        if (level < levels[findLogId(compName)]) {
+            return;
         }
+        va_list args; 
+        va_start(args, format); 
+        write(compName, level, true, format, args);
+        va_end(args);
+    }
+
+    void printf(LogId id, LogLevel level, const char *format, ...) __attribute__ ((format (printf, 4, 5))) {
+        updateLevel(level);
+        if (level < levels[id]) {
+            return;
+        }
+        va_list args; 
+        va_start(args, format); 
+        write(names[id], level, false, format, args);
+        va_end(args);
     }
 
     void printf(const char* compName, LogLevel level, const char *format, ...) __attribute__ ((format (printf, 4, 5))) {
         updateLevel(level);
-        if (out) {
-            if (level >= getLogLevel(compName)) {
-                va_list args; 
-                va_start(args, format); 
-                vsnprintf(buf, sizeof(buf), format, args); 
-                va_end(args);
-                out->print(buf);
-            }
+        if (level < levels[findLogId(compName)]) {
+            return;
         }
+        va_list args; 
+        va_start(args, format); 
+        write(compName, level, false, format, args);
+        va_end(args);
     }
 
     /**
-     * @brief Set the minumum LogLevel that will be logged, for the given component name
-     * Note that the compName* must be specified as a literal string ("someName") or at
-     * the very least as a char* that is pointing to a char[] that will be available and 
-     * constant through the life of the program.  This method will not copy the contents
-     * of the string, it only maintains the pointer you provide.
+     * @brief Set the minumum LogLevel that will be logged, for the given component name.
+     * Setting the level of LOGGER_NAME changes the default, used by every name that
+     * has no level of its own.
      * 
      * @param compName 
      * @param level 
      */
     void setLogLevel(const char* compName, LogLevel level) {
-        LogConfigEntry* head = logConfigList;
-        LogConfigEntry* entry = head;
-        while (entry != NULL) {
-            if (strcasecmp(entry->name, compName) == 0) {
-                break;
-            }
-            entry = entry->next;
+        LogId id = getLogId(compName);
+        if ((id == LOGGER_DEFAULT_ID) && (strcasecmp(compName, LOGGER_NAME) != 0)) {
+            return;     //No ids left
         }
-        if (entry == NULL) {
-            entry = new LogConfigEntry(compName, level);
-            entry->next = head->next;
-            head->next = entry;
+        explicitLevel[id] = true;
+        levels[id] = level;
+        if (id == LOGGER_DEFAULT_ID) {
+            for (LogId other = 1; other < idCount; other++) {
+                if (!explicitLevel[other]) {
+                    levels[other] = level;
+                }
+            }
         }
-        entry->level = level;
     }
 
     LogLevel getLogLevel(const char* compName) {
-        LogConfigEntry* head = logConfigList;
-        LogConfigEntry* entry = head;
-        while (entry != NULL) {
-            if (strcasecmp(entry->name, compName) == 0) {
-                break;
-            }
-            entry = entry->next;
-        }
-        if (entry == NULL) {
-            entry = head;
-        }
-        return entry->level;
+        return levels[findLogId(compName)];
     }
 
     LogLevel getMaxLevel() {
-        return maxLevel;
+        return maxLevel.load(std::memory_order_relaxed);
     }
 
     void clear() {
-        maxLevel = DEBUG;
+        maxLevel.store(DEBUG, std::memory_order_relaxed);
     }
 
 private:
     const char* const levelStr[7] = {
         "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
     Print* out = nullptr;
+    Clock* clock = nullptr;
     char buf[256] = {0};
-    LogLevel maxLevel = DEBUG;
-    LogConfigEntry* logConfigList = nullptr;
+    std::mutex outLock;             //guards out and buf, and is held by the consumer of the slots
+    std::atomic<LogLevel> maxLevel{DEBUG};
+
+    //Interned component names, indexed by LogId
+    char names[LOGGER_MAX_IDS][LOGGER_NAME_LEN] = {{0}};
+    volatile LogLevel levels[LOGGER_MAX_IDS] = {DEBUG};
+    bool explicitLevel[LOGGER_MAX_IDS] = {false};   //false while following the default level
+    volatile LogId idCount = 0;
+    std::mutex idLock;              //serializes the creation of ids
+
+    //Returns LOGGER_DEFAULT_ID for unknown names
+    LogId findLogId(const char* compName) const {
+        LogId count = idCount;
+        for (LogId id = 1; id < count; id++) {
+            if (strcasecmp(names[id], compName) == 0) {
+                return id;
+            }
+        }
+        return LOGGER_DEFAULT_ID;
+    }
+
+    //Output (or capture when deferred) a message that passed the level check
+    void write(const char* compName, LogLevel level, bool header, const char* format, va_list args) {
+        if (!out) {
+            return;
+        }
+        if (deferred) {
+            capture(compName, level, header, format, args);
+            return;
+        }
+        //Shared by the control task and the main loop
+        std::lock_guard<std::mutex> guard(outLock);
+        unsigned long now = clock ? clock->millis() : millis();
+        vsnprintf(buf, sizeof(buf), format, args); 
+        if (collapse(compName, level, header, now)) {
+            return;
+        }
+        if (header) {
+            out->printf("%s : %lu : %s : ", levelStr[level], now, compName);
+        }
+        out->print(buf);
+    }
+
+    //"Last message repeated N times" collapsing, only used under outLock
+    uint32_t repeatHash = 0;
+    const char* repeatName = nullptr;   //nullptr when the last message can not be repeated
+    LogLevel repeatLevel = DEBUG;
+    unsigned long repeatCount = 0;
+    unsigned long repeatSince = 0;      //Time of the first repeat not reported yet
+
+    //Returns true when the message in buf is the same as the one before it and was only
+    //  counted.  Only complete lines are compared, printf() fragments end the run.
+    bool collapse(const char* compName, LogLevel level, bool header, unsigned long now) {
+        size_t len = strlen(buf);
+        if (!header || (len == 0) || (buf[len - 1] != '\n')) {
+            reportRepeats(now);
+            repeatName = nullptr;
+            return false;
+        }
+        uint32_t hash = 2166136261u;        //FNV-1a
+        for (size_t index = 0; index < len; index++) {
+            hash = (hash ^ (uint8_t) buf[index]) * 16777619u;
+        }
+        if ((repeatName != nullptr) &&
+            (hash == repeatHash) &&
+            (level == repeatLevel) &&
+            (strcmp(compName, repeatName) == 0)) {
+            if (repeatCount == 0) {
+                repeatSince = now;
+            }
+            repeatCount++;
+            if ((now - repeatSince) >= LOGGER_REPEAT_REPORT_MS) {
+                reportRepeats(now);
+            }
+            return true;
+        }
+        reportRepeats(now);
+        repeatHash = hash;
+        repeatName = compName;
+        repeatLevel = level;
+        return false;
+    }
+
+    void reportRepeats(unsigned long now) {
+        if (repeatCount > 0) {
+            out->printf("%s : %lu : %s : Last message repeated %lu times\n", levelStr[repeatLevel], now, repeatName, repeatCount);
+            repeatCount = 0;
+        }
+    }
+
+    //Write out the deferred records, then a repeat count that is due (or any when final)
+    void drain(bool final) {
+        while (writeRecord()) {}
+        if (!out) {
+            return;
+        }
+        std::lock_guard<std::mutex> guard(outLock);
+        unsigned long now = clock ? clock->millis() : millis();
+        if ((repeatCount > 0) && (final || ((now - repeatSince) >= LOGGER_REPEAT_REPORT_MS))) {
+            reportRepeats(now);
+        }
+    }
+
+    //Deferred logging
+    volatile bool deferred = false;
+    volatile bool taskRunning = false;
+    static_assert((LOGGER_QUEUE_SIZE & (LOGGER_QUEUE_SIZE - 1)) == 0, "LOGGER_QUEUE_SIZE must be a power of 2");
+
+    //Bounded multi-producer ring: a producer claims a position with a CAS on enqueuePos,
+    //  fills the record and publishes it through the slot's sequence (position + 1).
+    //  The consumer frees the slot for the next lap with position + LOGGER_QUEUE_SIZE.
+    struct LogSlot {
+        std::atomic<uint32_t> sequence{0};
+        LogRecord record;
+    };
+    LogSlot slots[LOGGER_QUEUE_SIZE];
+    std::atomic<uint32_t> enqueuePos{0};
+    uint32_t dequeuePos = 0;        //Only used under outLock
+    LogRecord current;              //Record being written, only used under outLock
+    std::atomic<uint32_t> dropped{0};   //Records lost because the ring was full
+
+    static void taskEntry(void* param) {
+        Logger* logger = (Logger*) param;
+        while (true) {
+            vTaskDelay(pdMS_TO_TICKS(LOGGER_TASK_PERIOD_MS));
+            logger->drain(false);
+        }
+    }
+
+    //Parses one conversion of a printf format, format points just after the '%'
+    struct Conversion {
+        const char* end = nullptr;  //first char after the conversion
+        char flags[6] = {0};
+        bool widthArg = false;      //width given as '*'
+        bool precisionArg = false;  //precision given as '.*'
+        int width = -1;
+        int precision = -1;
+        uint8_t longs = 0;          //number of 'l', 'j' or 'z' (as 'l'), 'L' for doubles
+        uint8_t shorts = 0;         //number of 'h'
+        char type = 0;
+    };
+
+    static Conversion parseConversion(const char* format) {
+        Conversion conversion;
+        size_t flagCount = 0;
+        while ((*format != 0) && (strchr("-+ #0", *format) != NULL)) {
+            if (flagCount < sizeof(conversion.flags) - 1) {
+                conversion.flags[flagCount++] = *format;
+            }
+            format++;
+        }
+        if (*format == '*') {
+            conversion.widthArg = true;
+            format++;
+        } else if (isdigit(*format)) {
+            conversion.width = strtol(format, (char**) &format, 10);
+        }
+        if (*format == '.') {
+            format++;
+            if (*format == '*') {
+                conversion.precisionArg = true;
+                format++;
+            } else {
+                conversion.precision = strtol(format, (char**) &format, 10);
+            }
+        }
+        while ((*format != 0) && (strchr("hlLqjzt", *format) != NULL)) {
+            if (*format == 'h') {
+                conversion.shorts++;
+            } else {
+                conversion.longs++;
+            }
+            format++;
+        }
+        conversion.type = *format;
+        conversion.end = (*format != 0) ? format + 1 : format;
+        return conversion;
+    }
+
+    //Copy the raw arguments of a log() call into the next free record
+    void capture(const char* compName, LogLevel level, bool header, const char* format, va_list args) {
+        uint32_t position = enqueuePos.load(std::memory_order_relaxed);
+        LogSlot* slot;
+        while (true) {
+            slot = &slots[position % LOGGER_QUEUE_SIZE];
+            int32_t diff = (int32_t) (slot->sequence.load(std::memory_order_acquire) - position);
+            if (diff == 0) {
+                //Free for this lap, claim it (position is reloaded if another producer won)
+                if (enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                //Still holds the record of the previous lap, the ring is full
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                position = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        LogRecord& record = slot->record;
+        record.timestamp = clock ? clock->millis() : millis();
+        record.compName = compName;
+        record.format = format;
+        record.level = level;
+        record.header = header;
+        record.textLen = 0;
+        size_t argCount = 0;
+        const char* pos = format;
+        while ((pos = strchr(pos, '%')) != NULL) {
+            Conversion conversion = parseConversion(pos + 1);
+            pos = conversion.end;
+            if ((conversion.type == '%') || (conversion.type == 0)) {
+                continue;
+            }
+            if (conversion.widthArg && (argCount < LOGGER_MAX_ARGS)) {
+                record.args[argCount++].i = va_arg(args, int);
+            }
+            if (conversion.precisionArg && (argCount < LOGGER_MAX_ARGS)) {
+                record.args[argCount++].i = va_arg(args, int);
+            }
+            if (argCount >= LOGGER_MAX_ARGS) {
+                break;      //The rest of the format is written without its arguments
+            }
+            switch (conversion.type) {
+                case 'd': case 'i':
+                    if (conversion.longs >= 2) {
+                        record.args[argCount].i = va_arg(args, long long);
+                    } else if (conversion.longs == 1) {
+                        record.args[argCount].i = va_arg(args, long);
+                    } else if (conversion.shorts == 2) {
+                        record.args[argCount].i = (signed char) va_arg(args, int);
+                    } else if (conversion.shorts == 1) {
+                        record.args[argCount].i = (short) va_arg(args, int);
+                    } else {
+                        record.args[argCount].i = va_arg(args, int);
+                    }
+                    break;
+                case 'u': case 'x': case 'X': case 'o':
+                    if (conversion.longs >= 2) {
+                        record.args[argCount].i = va_arg(args, unsigned long long);
+                    } else if (conversion.longs == 1) {
+                        record.args[argCount].i = va_arg(args, unsigned long);
+                    } else if (conversion.shorts == 2) {
+                        record.args[argCount].i = (unsigned char) va_arg(args, unsigned int);
+                    } else if (conversion.shorts == 1) {
+                        record.args[argCount].i = (unsigned short) va_arg(args, unsigned int);
+                    } else {
+                        record.args[argCount].i = va_arg(args, unsigned int);
+                    }
+                    break;
+                case 'c':
+                    record.args[argCount].i = va_arg(args, int);
+                    break;
+                case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                    if (conversion.longs > 0) {
+                        record.args[argCount].d = (double) va_arg(args, long double);
+                    } else {
+                        record.args[argCount].d = va_arg(args, double);
+                    }
+                    break;
+                case 's': {
+                    //The string may not outlive the call, keep a (possibly truncated) copy
+                    const char* str = va_arg(args, const char*);
+                    if (str == NULL) {
+                        str = "(null)";
+                    }
+                    size_t room = sizeof(record.text) - record.textLen;
+                    size_t len = strnlen(str, (room > 0) ? room - 1 : 0);
+                    //With no room left the previous copy's terminator is used as an empty string
+                    record.args[argCount].i = (room > 0) ? record.textLen : record.textLen - 1;
+                    if (room > 0) {
+                        memcpy(&record.text[record.textLen], str, len);
+                        record.text[record.textLen + len] = 0;
+                        record.textLen += len + 1;
+                    }
+                    break;
+                }
+                default:    //'p' and 'n'
+                    record.args[argCount].p = va_arg(args, void*);
+                    break;
+            }
+            argCount++;
+        }
+        slot->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    //Format and write out the oldest record, returns false when there was none
+    bool writeRecord() {
+        std::lock_guard<std::mutex> guard(outLock);
+        unsigned long lost = dropped.exchange(0, std::memory_order_relaxed);
+        bool found = false;
+        LogSlot& slot = slots[dequeuePos % LOGGER_QUEUE_SIZE];
+        if (slot.sequence.load(std::memory_order_acquire) == dequeuePos + 1) {
+            current = slot.record;
+            slot.sequence.store(dequeuePos + LOGGER_QUEUE_SIZE, std::memory_order_release);
+            dequeuePos++;
+            found = true;
+        }
+        if (lost > 0) {
+            out->printf("%s : %lu : %s : %lu log records dropped\n", levelStr[WARN], (clock ? clock->millis() : millis()), LOGGER_NAME, lost);
+        }
+        if (!found) {
+            return false;
+        }
+        formatRecord(current);
+        if (collapse(current.compName, current.level, current.header, current.timestamp)) {
+            return true;
+        }
+        if (current.header) {
+            out->printf("%s : %lu : %s : ", levelStr[current.level], current.timestamp, current.compName);
+        }
+        out->print(buf);
+        return true;
+    }
+
+    //Rebuild the message of a record into buf, one conversion at a time
+    void formatRecord(const LogRecord& record) {
+        size_t len = 0;
+        size_t argCount = 0;
+        const char* pos = record.format;
+        while ((*pos != 0) && (len < sizeof(buf) - 1)) {
+            const char* percent = strchr(pos, '%');
+            size_t literal = (percent != NULL) ? (percent - pos) : strlen(pos);
+            literal = min(literal, sizeof(buf) - 1 - len);
+            memcpy(&buf[len], pos, literal);
+            len += literal;
+            pos += literal;
+            if ((percent == NULL) || (pos != percent)) {
+                break;
+            }
+
+            Conversion conversion = parseConversion(percent + 1);
+            pos = conversion.end;
+            if (conversion.type == '%') {
+                buf[len++] = '%';
+                continue;
+            }
+            if (conversion.type == 0) {
+                break;
+            }
+            int width = conversion.width;
+            int precision = conversion.precision;
+            if (conversion.widthArg && (argCount < LOGGER_MAX_ARGS)) {
+                width = record.args[argCount++].i;
+            }
+            if (conversion.precisionArg && (argCount < LOGGER_MAX_ARGS)) {
+                precision = record.args[argCount++].i;
+            }
+            if (argCount >= LOGGER_MAX_ARGS) {
+                //Out of captured arguments, the rest of the format is written as it is
+                size_t rest = min(strlen(percent), sizeof(buf) - 1 - len);
+                memcpy(&buf[len], percent, rest);
+                len += rest;
+                break;
+            }
+
+            //Same conversion, with every integer widened to the long long it was captured as
+            char spec[24];
+            size_t specLen = snprintf(spec, sizeof(spec), "%%%s", conversion.flags);
+            if (width >= 0) {
+                specLen += snprintf(&spec[specLen], sizeof(spec) - specLen, "%d", width);
+            }
+            if (precision >= 0) {
+                specLen += snprintf(&spec[specLen], sizeof(spec) - specLen, ".%d", precision);
+            }
+            size_t room = sizeof(buf) - len;
+            int written = 0;
+            switch (conversion.type) {
+                case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+                    snprintf(&spec[specLen], sizeof(spec) - specLen, "ll%c", conversion.type);
+                    written = snprintf(&buf[len], room, spec, record.args[argCount].i);
+                    break;
+                case 'c':
+                    snprintf(&spec[specLen], sizeof(spec) - specLen, "c");
+                    written = snprintf(&buf[len], room, spec, (int) record.args[argCount].i);
+                    break;
+                case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                    snprintf(&spec[specLen], sizeof(spec) - specLen, "%c", conversion.type);
+                    written = snprintf(&buf[len], room, spec, record.args[argCount].d);
+                    break;
+                case 's':
+                    snprintf(&spec[specLen], sizeof(spec) - specLen, "s");
+                    written = snprintf(&buf[len], room, spec, &record.text[record.args[argCount].i]);
+                    break;
+                case 'p':
+                    snprintf(&spec[specLen], sizeof(spec) - specLen, "p");
+                    written = snprintf(&buf[len], room, spec, record.args[argCount].p);
+                    break;
+                default:
+                    break;
+            }
+            argCount++;
+            if (written > 0) {
+                len = min(len + (size_t) written, sizeof(buf) - 1);
+            }
+        }
+        buf[len] = 0;
+    }
 
+    //Only WARN and above are tracked, getMaxLevel() is read for the failsafe
     void updateLevel(LogLevel newLevel) {
-        if (newLevel > maxLevel) {
-            maxLevel = newLevel;
+        if (newLevel < WARN) {
+            return;
         }
+        LogLevel level = maxLevel.load(std::memory_order_relaxed);
+        while ((newLevel > level) &&
+               !maxLevel.compare_exchange_weak(level, newLevel, std::memory_order_relaxed)) {}
     }
 };
@@ -0,0 +1,176 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include "Arduino.h"
+#include "Wire.h"
+
+#define PCA9685_MODE1 0x00
+#define PCA9685_MODE2 0x01
+#define PCA9685_LED0_ON_L 0x06
+#define PCA9685_PRESCALE 0xFE
+
+#define MODE1_RESTART 0x80
+#define MODE1_SLEEP 0x10
+#define MODE1_AI 0x20
+#define MODE2_OUTDRV 0x04
+
+#define FREQUENCY_OSCILLATOR 25000000
+#define PCA9685_PRESCALE_MIN 3
+#define PCA9685_PRESCALE_MAX 255
+
+/**
+ * Host stand-in for the Adafruit PCA9685 library.  The chip registers are
+ * modelled in RAM and every register access is issued on the TwoWire shim
+ * with the same transaction shape as the real library, so I2C traffic can
+ * be counted on the host.
+ */
+class Adafruit_PWMServoDriver {
+public:
+    Adafruit_PWMServoDriver(const uint8_t addr = 0x40) :
+        i2cAddr(addr),
+        i2c(&Wire) {}
+
+    Adafruit_PWMServoDriver(const uint8_t addr, TwoWire& i2c) :
+        i2cAddr(addr),
+        i2c(&i2c) {}
+
+    bool begin(uint8_t prescale = 0) {
+        reset();
+        if (prescale) {
+            setExtClk(prescale);
+        } else {
+            setPWMFreq(1000);
+        }
+        return true;
+    }
+
+    void reset() {
+        write8(PCA9685_MODE1, MODE1_RESTART);
+    }
+
+    void sleep() {
+        write8(PCA9685_MODE1, read8(PCA9685_MODE1) | MODE1_SLEEP);
+    }
+
+    void wakeup() {
+        write8(PCA9685_MODE1, read8(PCA9685_MODE1) & ~MODE1_SLEEP);
+    }
+
+    void setExtClk(uint8_t prescale) {
+        write8(PCA9685_PRESCALE, prescale);
+    }
+
+    void setPWMFreq(float freq) {
+        if (freq < 1) {
+            freq = 1;
+        }
+        if (freq > 3500) {
+            freq = 3500;
+        }
+        float prescaleval = ((oscillatorFreq / (freq * 4096.0)) + 0.5) - 1;
+        if (prescaleval < PCA9685_PRESCALE_MIN) {
+            prescaleval = PCA9685_PRESCALE_MIN;
+        }
+        if (prescaleval > PCA9685_PRESCALE_MAX) {
+            prescaleval = PCA9685_PRESCALE_MAX;
+        }
+        uint8_t oldmode = read8(PCA9685_MODE1);
+        write8(PCA9685_MODE1, (oldmode & ~MODE1_RESTART) | MODE1_SLEEP);
+        write8(PCA9685_PRESCALE, (uint8_t) prescaleval);
+        write8(PCA9685_MODE1, oldmode);
+        write8(PCA9685_MODE1, oldmode | MODE1_RESTART | MODE1_AI);
+    }
+
+    void setOutputMode(bool totempole) {
+        uint8_t oldmode = read8(PCA9685_MODE2);
+        write8(PCA9685_MODE2, totempole ? (oldmode | MODE2_OUTDRV) : (oldmode & ~MODE2_OUTDRV));
+    }
+
+    uint8_t readPrescale() {
+        return read8(PCA9685_PRESCALE);
+    }
+
+    uint16_t getPWM(uint8_t num, bool off = false) {
+        uint8_t reg = PCA9685_LED0_ON_L + (4 * num) + (off ? 2 : 0);
+        i2c->requestFrom(i2cAddr, (uint8_t) 2);
+        return regs[reg] | (regs[reg + 1] << 8);
+    }
+
+    uint8_t setPWM(uint8_t num, uint16_t on, uint16_t off) {
+        uint8_t reg = PCA9685_LED0_ON_L + (4 * num);
+        i2c->beginTransmission(i2cAddr);
+        i2c->write(reg);
+        i2c->write(on);
+        i2c->write(on >> 8);
+        i2c->write(off);
+        i2c->write(off >> 8);
+        regs[reg] = on;
+        regs[reg + 1] = on >> 8;
+        regs[reg + 2] = off;
+        regs[reg + 3] = off >> 8;
+        return i2c->endTransmission();
+    }
+
+    void setPin(uint8_t num, uint16_t val, bool invert = false) {
+        val = std::min(val, (uint16_t) 4095);
+        if (invert) {
+            val = 4095 - val;
+        }
+        if (val == 4095) {
+            setPWM(num, 4096, 0);
+        } else if (val == 0) {
+            setPWM(num, 0, 4096);
+        } else {
+            setPWM(num, 0, val);
+        }
+    }
+
+    void writeMicroseconds(uint8_t num, uint16_t microseconds) {
+        double pulse = microseconds;
+        double pulselength = 1000000;
+        uint16_t prescale = readPrescale();
+        prescale += 1;
+        pulselength *= prescale;
+        pulselength /= oscillatorFreq;
+        pulse /= pulselength;
+        setPWM(num, 0, pulse);
+    }
+
+    uint32_t getOscillatorFrequency() {
+        return oscillatorFreq;
+    }
+
+    void setOscillatorFrequency(uint32_t freq) {
+        oscillatorFreq = freq;
+    }
+
+private:
+    uint8_t i2cAddr;
+    TwoWire* i2c;
+    uint32_t oscillatorFreq = FREQUENCY_OSCILLATOR;
+    uint8_t regs[256] = {0};
+
+    uint8_t read8(uint8_t addr) {
+        i2c->beginTransmission(i2cAddr);
+        i2c->write(addr);
+        i2c->endTransmission();
+        i2c->requestFrom(i2cAddr, (uint8_t) 1);
+        return regs[addr];
+    }
+
+    void write8(uint8_t addr, uint8_t d) {
+        i2c->beginTransmission(i2cAddr);
+        i2c->write(addr);
+        i2c->write(d);
+        i2c->endTransmission();
+        regs[addr] = d;
+    }
+};
@@ -0,0 +1,20 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <cstdint>
+
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    void restart();
+};
+
+extern EspClass ESP;
@@ -0,0 +1,48 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include "Stream.h"
+
+#define SERIAL_8N1 0x800001c
+
+/**
+ * Host stand-in for the ESP32 HardwareSerial.  Serial is bound to the
+ * process stdin/stdout (stdin is polled without blocking), the other ports
+ * are sinks that only count the bytes written to them.
+ */
+class HardwareSerial : public Stream {
+public:
+    HardwareSerial(int uartNum);
+
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1);
+    void end() {}
+
+    int available() override;
+    int read() override;
+    int peek() override;
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int availableForWrite() override;
+    void flush() override;
+
+    unsigned long bytesWritten() const {return txCount;}
+
+private:
+    int uartNum;
+    int peeked = -1;
+    unsigned long txCount = 0;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
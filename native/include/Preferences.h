@@ -0,0 +1,106 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include "Arduino.h"
+#include <map>
+#include <string>
+#include <vector>
+
+typedef enum {
+    PT_I8, PT_U8, PT_I16, PT_U16, PT_I32, PT_U32, PT_I64, PT_U64, PT_STR, PT_BLOB, PT_INVALID
+} PreferenceType;
+
+/**
+ * Host stand-in for the ESP32 Preferences (NVS) library.  Entries live in a
+ * process-wide in-memory store so they survive across Preferences instances
+ * the same way NVS survives across begin()/end() pairs.  Namespace and key
+ * names are limited to 15 characters, as on the device.
+ *
+ * Every committed write is counted and can optionally be charged a fixed
+ * busy-wait (writeDelayMicros) to approximate flash commit cost.
+ */
+class Preferences {
+public:
+    static unsigned long writeCount;
+    static unsigned long readCount;
+    static uint32_t writeDelayMicros;
+
+    bool begin(const char* name, bool readOnly = false, const char* partitionLabel = NULL);
+    void end();
+
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+    PreferenceType getType(const char* key);
+    size_t freeEntries();
+
+    size_t putChar(const char* key, int8_t value) {return putRaw(key, PT_I8, &value, sizeof(value));}
+    size_t putUChar(const char* key, uint8_t value) {return putRaw(key, PT_U8, &value, sizeof(value));}
+    size_t putShort(const char* key, int16_t value) {return putRaw(key, PT_I16, &value, sizeof(value));}
+    size_t putUShort(const char* key, uint16_t value) {return putRaw(key, PT_U16, &value, sizeof(value));}
+    size_t putInt(const char* key, int32_t value) {return putRaw(key, PT_I32, &value, sizeof(value));}
+    size_t putUInt(const char* key, uint32_t value) {return putRaw(key, PT_U32, &value, sizeof(value));}
+    size_t putLong(const char* key, int32_t value) {return putInt(key, value);}
+    size_t putULong(const char* key, uint32_t value) {return putUInt(key, value);}
+    size_t putLong64(const char* key, int64_t value) {return putRaw(key, PT_I64, &value, sizeof(value));}
+    size_t putULong64(const char* key, uint64_t value) {return putRaw(key, PT_U64, &value, sizeof(value));}
+    size_t putFloat(const char* key, float value) {return putRaw(key, PT_BLOB, &value, sizeof(value));}
+    size_t putDouble(const char* key, double value) {return putRaw(key, PT_BLOB, &value, sizeof(value));}
+    size_t putBool(const char* key, bool value) {return putUChar(key, value ? 1 : 0);}
+    size_t putString(const char* key, const char* value);
+    size_t putString(const char* key, const String& value) {return putString(key, value.c_str());}
+    size_t putBytes(const char* key, const void* value, size_t len) {return putRaw(key, PT_BLOB, value, len);}
+
+    int8_t getChar(const char* key, int8_t defaultValue = 0) {return getScalar(key, PT_I8, defaultValue);}
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0) {return getScalar(key, PT_U8, defaultValue);}
+    int16_t getShort(const char* key, int16_t defaultValue = 0) {return getScalar(key, PT_I16, defaultValue);}
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0) {return getScalar(key, PT_U16, defaultValue);}
+    int32_t getInt(const char* key, int32_t defaultValue = 0) {return getScalar(key, PT_I32, defaultValue);}
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0) {return getScalar(key, PT_U32, defaultValue);}
+    int32_t getLong(const char* key, int32_t defaultValue = 0) {return getInt(key, defaultValue);}
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0) {return getUInt(key, defaultValue);}
+    int64_t getLong64(const char* key, int64_t defaultValue = 0) {return getScalar(key, PT_I64, defaultValue);}
+    uint64_t getULong64(const char* key, uint64_t defaultValue = 0) {return getScalar(key, PT_U64, defaultValue);}
+    float getFloat(const char* key, float defaultValue = NAN) {return getScalar(key, PT_BLOB, defaultValue);}
+    double getDouble(const char* key, double defaultValue = NAN) {return getScalar(key, PT_BLOB, defaultValue);}
+    bool getBool(const char* key, bool defaultValue = false) {return getUChar(key, defaultValue ? 1 : 0) == 1;}
+    String getString(const char* key, const char* defaultValue = NULL);
+    size_t getString(const char* key, char* value, size_t maxLen);
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buf, size_t maxLen);
+
+private:
+    struct Entry {
+        PreferenceType type = PT_INVALID;
+        std::vector<uint8_t> data;
+    };
+    typedef std::map<std::string, Entry> Namespace;
+
+    Namespace* current = nullptr;
+    bool readOnly = false;
+
+    static std::map<std::string, Namespace>& store();
+    static void chargeWrite();
+
+    size_t putRaw(const char* key, PreferenceType type, const void* value, size_t len);
+    const Entry* find(const char* key, PreferenceType type);
+
+    template <typename T>
+    T getScalar(const char* key, PreferenceType type, T defaultValue) {
+        const Entry* entry = find(key, type);
+        if ((entry == nullptr) || (entry->data.size() != sizeof(T))) {
+            return defaultValue;
+        }
+        T value;
+        memcpy(&value, entry->data.data(), sizeof(T));
+        return value;
+    }
+};
@@ -0,0 +1,69 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) {
+            if (write(*buffer++)) {
+                n++;
+            } else {
+                break;
+            }
+        }
+        return n;
+    }
+    size_t write(const char* str) {
+        if (str == NULL) {
+            return 0;
+        }
+        return write((const uint8_t*) str, strlen(str));
+    }
+    size_t write(const char* buffer, size_t size) {
+        return write((const uint8_t*) buffer, size);
+    }
+
+    virtual int availableForWrite() {return 0;}
+    virtual void flush() {}
+
+    size_t printf(const char* format, ...) __attribute__ ((format (printf, 2, 3)));
+
+    size_t print(const char* str) {return write(str);}
+    size_t print(const String& str) {return write(str.c_str());}
+    size_t print(char c) {return write((uint8_t) c);}
+    size_t print(unsigned char value, int base = DEC) {return print((unsigned long) value, base);}
+    size_t print(int value, int base = DEC) {return print((long) value, base);}
+    size_t print(unsigned int value, int base = DEC) {return print((unsigned long) value, base);}
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    size_t println() {return print("\r\n");}
+    template <typename T>
+    size_t println(T value) {
+        size_t n = print(value);
+        return n + println();
+    }
+};
@@ -0,0 +1,41 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include "Arduino.h"
+
+#define SWSERIAL_8N1 0x1c
+
+namespace EspSoftwareSerial {
+    /**
+     * Host stand-in for the EspSoftwareSerial UART.  Output is discarded
+     * (and counted), no input is ever available.
+     */
+    class UART : public Stream {
+    public:
+        void begin(uint32_t baud, int config = SWSERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1) {}
+
+        int available() override {return 0;}
+        int read() override {return -1;}
+        int peek() override {return -1;}
+
+        size_t write(uint8_t c) override {
+            txCount++;
+            return 1;
+        }
+        using Print::write;
+        int availableForWrite() override {return 128;}
+
+        unsigned long bytesWritten() const {return txCount;}
+
+    private:
+        unsigned long txCount = 0;
+    };
+}
@@ -0,0 +1,66 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <string>
+#include <cstring>
+#include <strings.h>
+
+/**
+ * Host (native) stand-in for the Arduino String class.
+ * Only the subset of the API used by MechMind is provided.
+ */
+class String {
+public:
+    String() {}
+    String(const char* cstr) : value(cstr ? cstr : "") {}
+    String(const String& other) = default;
+    explicit String(char c) : value(1, c) {}
+    explicit String(int number) : value(std::to_string(number)) {}
+    explicit String(unsigned long number) : value(std::to_string(number)) {}
+
+    String& operator=(const String& other) = default;
+    String& operator=(const char* cstr) {
+        value = cstr ? cstr : "";
+        return *this;
+    }
+
+    const char* c_str() const {return value.c_str();}
+    unsigned int length() const {return value.length();}
+    bool isEmpty() const {return value.empty();}
+
+    bool equals(const String& other) const {return value == other.value;}
+    bool equals(const char* cstr) const {return value == (cstr ? cstr : "");}
+    bool equalsIgnoreCase(const String& other) const {return strcasecmp(c_str(), other.c_str()) == 0;}
+
+    bool operator==(const String& other) const {return equals(other);}
+    bool operator==(const char* cstr) const {return equals(cstr);}
+    bool operator!=(const String& other) const {return !equals(other);}
+    bool operator!=(const char* cstr) const {return !equals(cstr);}
+    bool operator<(const String& other) const {return value < other.value;}
+
+    String& operator+=(const String& other) {
+        value += other.value;
+        return *this;
+    }
+    String& operator+=(const char* cstr) {
+        value += (cstr ? cstr : "");
+        return *this;
+    }
+    String& operator+=(char c) {
+        value += c;
+        return *this;
+    }
+
+    char operator[](unsigned int index) const {return (index < value.length()) ? value[index] : 0;}
+
+private:
+    std::string value;
+};
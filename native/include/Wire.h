@@ -0,0 +1,48 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include "Arduino.h"
+
+/**
+ * Host stand-in for the Arduino TwoWire (I2C) bus.  There are no devices
+ * on the bus; every transmission is acknowledged and counted so bus
+ * traffic can be measured.
+ */
+class TwoWire {
+public:
+    bool begin() {return true;}
+    void setClock(uint32_t frequency) {}
+
+    void beginTransmission(uint8_t address) {transactions++;}
+    size_t write(uint8_t data) {
+        txBytes++;
+        return 1;
+    }
+    uint8_t endTransmission(bool sendStop = true) {return 0;}
+
+    uint8_t requestFrom(uint8_t address, uint8_t quantity) {
+        transactions++;
+        rxBytes += quantity;
+        return quantity;
+    }
+    int read() {return 0;}
+
+    unsigned long getTransactions() const {return transactions;}
+    unsigned long getBytesWritten() const {return txBytes;}
+    unsigned long getBytesRead() const {return rxBytes;}
+
+private:
+    unsigned long transactions = 0;
+    unsigned long txBytes = 0;
+    unsigned long rxBytes = 0;
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,37 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <cstdint>
+
+/**
+ * Host stand-in for the subset of the ESP-IDF FreeRTOS API used by MechMind.
+ * Tasks are mapped onto std::thread, the tick is 1 millisecond (as configured
+ * for the Arduino-ESP32 core).
+ */
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define configTICK_RATE_HZ      1000
+#define configMAX_PRIORITIES    25
+#define portTICK_PERIOD_MS      (1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY           ((TickType_t) 0xffffffffUL)
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t) (((TickType_t) (xTimeInMs) * (TickType_t) configTICK_RATE_HZ) / (TickType_t) 1000U))
+
+#define pdFALSE     ((BaseType_t) 0)
+#define pdTRUE      ((BaseType_t) 1)
+#define pdFAIL      (pdFALSE)
+#define pdPASS      (pdTRUE)
+
+#define tskNO_AFFINITY  ((BaseType_t) 0x7FFFFFFF)
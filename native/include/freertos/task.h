@@ -0,0 +1,62 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include "freertos/FreeRTOS.h"
+#include <chrono>
+#include <thread>
+
+namespace freertos_native {
+    inline std::chrono::steady_clock::time_point tickEpoch() {
+        static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        return epoch;
+    }
+}
+
+inline TickType_t xTaskGetTickCount() {
+    return (TickType_t) std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - freertos_native::tickEpoch()).count();
+}
+
+inline void vTaskDelay(const TickType_t xTicksToDelay) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(xTicksToDelay * portTICK_PERIOD_MS));
+}
+
+inline BaseType_t xTaskDelayUntil(TickType_t* const pxPreviousWakeTime, const TickType_t xTimeIncrement) {
+    TickType_t wakeTime = *pxPreviousWakeTime + xTimeIncrement;
+    *pxPreviousWakeTime = wakeTime;
+    if ((int32_t) (wakeTime - xTaskGetTickCount()) <= 0) {
+        return pdFALSE;
+    }
+    std::this_thread::sleep_until(freertos_native::tickEpoch() + std::chrono::milliseconds(wakeTime * portTICK_PERIOD_MS));
+    return pdTRUE;
+}
+
+inline void vTaskDelayUntil(TickType_t* const pxPreviousWakeTime, const TickType_t xTimeIncrement) {
+    xTaskDelayUntil(pxPreviousWakeTime, xTimeIncrement);
+}
+
+/**
+ * Priority and core affinity are ignored on the host, the task runs on a
+ * detached std::thread for the rest of the process lifetime.
+ */
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char* const pcName, const uint32_t usStackDepth,
+                                          void* const pvParameters, UBaseType_t uxPriority, TaskHandle_t* const pvCreatedTask, const BaseType_t xCoreID) {
+    std::thread* thread = new std::thread(pvTaskCode, pvParameters);
+    if (pvCreatedTask != nullptr) {
+        *pvCreatedTask = (TaskHandle_t) thread;
+    }
+    thread->detach();
+    return pdPASS;
+}
+
+inline BaseType_t xPortGetCoreID() {
+    return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the Reeltwo CytronSmartDriveDuoDriver (Packetized
+ * Serial mode).  Each motor() call writes one 4 byte packet (header,
+ * address, left speed, right speed) to the supplied Stream.
+ */
+class CytronSmartDriveDuoDriver {
+public:
+    CytronSmartDriveDuoDriver(byte address, Stream& port, uint8_t initialByte = 0x80) :
+        address(address),
+        port(&port),
+        initialByte(initialByte) {}
+
+    void motor(int leftPower, int rightPower) {
+        leftPower = std::max(-128, std::min(127, leftPower));
+        rightPower = std::max(-128, std::min(127, rightPower));
+        uint8_t packet[4];
+        packet[0] = initialByte;
+        packet[1] = address;
+        packet[2] = (uint8_t) (leftPower + 128);
+        packet[3] = (uint8_t) (rightPower + 128);
+        port->write(packet, sizeof(packet));
+    }
+
+    void stop() {
+        motor(0, 0);
+    }
+
+private:
+    byte address;
+    Stream* port;
+    uint8_t initialByte;
+};
@@ -0,0 +1,69 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#pragma once
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the Reeltwo SabertoothDriver (Packetized Serial mode).
+ * Commands are encoded exactly like the real driver (address, command,
+ * value, checksum) and written to the supplied Stream.
+ */
+class SabertoothDriver {
+public:
+    SabertoothDriver(byte address, Stream& port) :
+        address(address),
+        port(&port) {}
+
+    void motor(byte motor, int power) {
+        if ((motor < 1) || (motor > 2)) {
+            return;
+        }
+        power = std::max(-127, std::min(127, power));
+        command((motor == 2 ? 4 : 0) + (power < 0 ? 1 : 0), (byte) abs(power));
+    }
+
+    void drive(int power) {
+        power = std::max(-127, std::min(127, power));
+        command(power < 0 ? 9 : 8, (byte) abs(power));
+    }
+
+    void turn(int power) {
+        power = std::max(-127, std::min(127, power));
+        command(power < 0 ? 11 : 10, (byte) abs(power));
+    }
+
+    void stop() {
+        motor(1, 0);
+        motor(2, 0);
+    }
+
+    void setMinVoltage(byte value) {command(2, (byte) std::min((int) value, 120));}
+    void setMaxVoltage(byte value) {command(3, (byte) std::min((int) value, 127));}
+    void setBaudRate(long baudRate) {}
+    void setDeadband(byte value) {command(17, (byte) std::min((int) value, 127));}
+    void setRamping(byte value) {command(16, (byte) std::min((int) value, 80));}
+    void setTimeout(int milliseconds) {
+        command(14, (byte) ((std::min(milliseconds, 12700) + 99) / 100));
+    }
+
+private:
+    byte address;
+    Stream* port;
+
+    void command(byte command, byte value) {
+        uint8_t packet[4];
+        packet[0] = address;
+        packet[1] = command;
+        packet[2] = value;
+        packet[3] = (address + command + value) & 0x7F;
+        port->write(packet, sizeof(packet));
+    }
+};
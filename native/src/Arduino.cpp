@@ -0,0 +1,149 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <thread>
+
+namespace {
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+}
+
+unsigned long millis() {
+    return (unsigned long) std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+}
+
+unsigned long micros() {
+    return (unsigned long) std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+
+void digitalWrite(uint8_t pin, uint8_t val) {}
+
+int digitalRead(uint8_t pin) {
+    return LOW;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    const long dividend = out_max - out_min;
+    const long divisor = in_max - in_min;
+    const long delta = x - in_min;
+    if (divisor == 0) {
+        return -1;
+    }
+    return (delta * dividend + (divisor / 2)) / divisor + out_min;
+}
+
+long random(long howbig) {
+    if (howbig <= 0) {
+        return 0;
+    }
+    return ::random() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) {
+        return howsmall;
+    }
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) {
+        srandom(seed);
+    }
+}
+
+const char* strnstr(const char* haystack, const char* needle, size_t len) {
+    size_t needleLen = strlen(needle);
+    if (needleLen == 0) {
+        return haystack;
+    }
+    for (size_t i = 0; (i + needleLen <= len) && (haystack[i] != '\0'); i++) {
+        if (strncmp(&haystack[i], needle, needleLen) == 0) {
+            return &haystack[i];
+        }
+    }
+    return NULL;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char loc_buf[64];
+    char* temp = loc_buf;
+    va_list arg;
+    va_list copy;
+    va_start(arg, format);
+    va_copy(copy, arg);
+    int len = vsnprintf(temp, sizeof(loc_buf), format, copy);
+    va_end(copy);
+    if (len < 0) {
+        va_end(arg);
+        return 0;
+    }
+    if (len >= (int) sizeof(loc_buf)) {
+        temp = (char*) malloc(len + 1);
+        if (temp == NULL) {
+            va_end(arg);
+            return 0;
+        }
+        len = vsnprintf(temp, len + 1, format, arg);
+    }
+    va_end(arg);
+    len = write((uint8_t*) temp, len);
+    if (temp != loc_buf) {
+        free(temp);
+    }
+    return len;
+}
+
+size_t Print::print(long value, int base) {
+    char buf[8 * sizeof(long) + 2];
+    if (base == 10) {
+        snprintf(buf, sizeof(buf), "%ld", value);
+        return write(buf);
+    }
+    return print((unsigned long) value, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+    char buf[8 * sizeof(long) + 1];
+    char* str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    if (base < 2) {
+        base = 10;
+    }
+    do {
+        unsigned long digit = value % base;
+        value /= base;
+        *--str = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+    } while (value);
+    return write(str);
+}
+
+size_t Print::print(double value, int digits) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", digits, value);
+    return write(buf);
+}
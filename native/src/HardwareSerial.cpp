@@ -0,0 +1,98 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <poll.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+TwoWire Wire;
+EspClass ESP;
+
+#define SERIAL_TX_BUFFER_SIZE 128
+
+HardwareSerial::HardwareSerial(int uartNum) :
+    uartNum(uartNum) {}
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int8_t rxPin, int8_t txPin) {}
+
+int HardwareSerial::available() {
+    if (uartNum != 0) {
+        return 0;
+    }
+    if (peeked >= 0) {
+        return 1;
+    }
+    struct pollfd fds = {STDIN_FILENO, POLLIN, 0};
+    if ((poll(&fds, 1, 0) > 0) && (fds.revents & POLLIN)) {
+        uint8_t c;
+        if (::read(STDIN_FILENO, &c, 1) == 1) {
+            peeked = c;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int HardwareSerial::read() {
+    if (!available()) {
+        return -1;
+    }
+    int c = peeked;
+    peeked = -1;
+    return c;
+}
+
+int HardwareSerial::peek() {
+    if (!available()) {
+        return -1;
+    }
+    return peeked;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    txCount += size;
+    if (uartNum == 0) {
+        fwrite(buffer, 1, size, stdout);
+    }
+    return size;
+}
+
+int HardwareSerial::availableForWrite() {
+    return SERIAL_TX_BUFFER_SIZE;
+}
+
+void HardwareSerial::flush() {
+    if (uartNum == 0) {
+        fflush(stdout);
+    }
+}
+
+uint32_t EspClass::getFreeHeap() {
+#if defined(__GLIBC__)
+    return (uint32_t) mallinfo2().fordblks;
+#else
+    return 0;
+#endif
+}
+
+void EspClass::restart() {
+    fflush(stdout);
+    _exit(0);
+}
@@ -0,0 +1,145 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include <Preferences.h>
+
+#define NVS_KEY_NAME_MAX_SIZE 15
+#define NVS_ENTRY_COUNT 2016
+
+unsigned long Preferences::writeCount = 0;
+unsigned long Preferences::readCount = 0;
+uint32_t Preferences::writeDelayMicros = 0;
+
+std::map<std::string, Preferences::Namespace>& Preferences::store() {
+    static std::map<std::string, Namespace> nvs;
+    return nvs;
+}
+
+void Preferences::chargeWrite() {
+    writeCount++;
+    if (writeDelayMicros > 0) {
+        unsigned long start = micros();
+        while ((micros() - start) < writeDelayMicros) {}
+    }
+}
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partitionLabel) {
+    if ((name == NULL) || (strlen(name) > NVS_KEY_NAME_MAX_SIZE) || (current != nullptr)) {
+        return false;
+    }
+    current = &store()[name];
+    this->readOnly = readOnly;
+    return true;
+}
+
+void Preferences::end() {
+    current = nullptr;
+}
+
+bool Preferences::clear() {
+    if ((current == nullptr) || readOnly) {
+        return false;
+    }
+    current->clear();
+    chargeWrite();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if ((current == nullptr) || readOnly || (current->erase(key) == 0)) {
+        return false;
+    }
+    chargeWrite();
+    return true;
+}
+
+bool Preferences::isKey(const char* key) {
+    return getType(key) != PT_INVALID;
+}
+
+PreferenceType Preferences::getType(const char* key) {
+    if ((current == nullptr) || (key == NULL)) {
+        return PT_INVALID;
+    }
+    auto it = current->find(key);
+    if (it == current->end()) {
+        return PT_INVALID;
+    }
+    return it->second.type;
+}
+
+size_t Preferences::freeEntries() {
+    size_t used = 0;
+    for (auto& nspace : store()) {
+        used += nspace.second.size() + 1;
+    }
+    return (used < NVS_ENTRY_COUNT) ? (NVS_ENTRY_COUNT - used) : 0;
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+    if (value == NULL) {
+        return 0;
+    }
+    return putRaw(key, PT_STR, value, strlen(value) + 1) ? strlen(value) : 0;
+}
+
+String Preferences::getString(const char* key, const char* defaultValue) {
+    const Entry* entry = find(key, PT_STR);
+    if (entry == nullptr) {
+        return String(defaultValue);
+    }
+    return String((const char*) entry->data.data());
+}
+
+size_t Preferences::getString(const char* key, char* value, size_t maxLen) {
+    const Entry* entry = find(key, PT_STR);
+    if ((entry == nullptr) || (value == NULL) || (entry->data.size() > maxLen)) {
+        return 0;
+    }
+    memcpy(value, entry->data.data(), entry->data.size());
+    return entry->data.size();
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    const Entry* entry = find(key, PT_BLOB);
+    return (entry == nullptr) ? 0 : entry->data.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+    const Entry* entry = find(key, PT_BLOB);
+    if ((entry == nullptr) || (buf == NULL) || (entry->data.size() > maxLen)) {
+        return 0;
+    }
+    memcpy(buf, entry->data.data(), entry->data.size());
+    return entry->data.size();
+}
+
+size_t Preferences::putRaw(const char* key, PreferenceType type, const void* value, size_t len) {
+    if ((current == nullptr) || readOnly || (key == NULL) || (strlen(key) > NVS_KEY_NAME_MAX_SIZE)) {
+        return 0;
+    }
+    Entry& entry = (*current)[key];
+    entry.type = type;
+    entry.data.assign((const uint8_t*) value, ((const uint8_t*) value) + len);
+    chargeWrite();
+    return len;
+}
+
+const Preferences::Entry* Preferences::find(const char* key, PreferenceType type) {
+    readCount++;
+    if ((current == nullptr) || (key == NULL)) {
+        return nullptr;
+    }
+    auto it = current->find(key);
+    if ((it == current->end()) || (it->second.type != type)) {
+        return nullptr;
+    }
+    return &it->second;
+}
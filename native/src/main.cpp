@@ -0,0 +1,113 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <Wire.h>
+#include "shared/common/Clock.h"
+#include <atomic>
+#include <new>
+
+//Used by src/main.cpp when creating the System, nullptr selects the RealClock
+Clock* nativeClock = nullptr;
+
+//Every heap allocation made through new, so the summary can show the loop() hot path allocates nothing
+static std::atomic<unsigned long> allocationCount{0};
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(size ? size : 1);
+    if (ptr == NULL) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t size) noexcept {
+    free(ptr);
+}
+
+/**
+ * Entry point for the [env:native] build.  Runs the regular Arduino
+ * setup()/loop() from src/main.cpp on the host.
+ *
+ * Usage: program [loopCount]
+ *   loopCount - number of loop() iterations to run before exiting and
+ *               printing the loop timing summary (default: run forever)
+ *
+ * Environment:
+ *   MECHMIND_NVS_WRITE_US - simulated cost in microseconds of each NVS write
+ *   MECHMIND_VIRTUAL_CLOCK_US - run on a VirtualClock that advances this many
+ *               microseconds after every loop() instead of on wall-clock time
+ */
+int main(int argc, char** argv) {
+    long loopCount = -1;
+    if (argc > 1) {
+        loopCount = strtol(argv[1], NULL, 10);
+    }
+    const char* nvsWriteUs = getenv("MECHMIND_NVS_WRITE_US");
+    if (nvsWriteUs != NULL) {
+        Preferences::writeDelayMicros = strtoul(nvsWriteUs, NULL, 10);
+    }
+    static VirtualClock virtualClock;
+    uint32_t virtualStep = 0;
+    const char* virtualClockUs = getenv("MECHMIND_VIRTUAL_CLOCK_US");
+    if (virtualClockUs != NULL) {
+        virtualStep = strtoul(virtualClockUs, NULL, 10);
+        nativeClock = &virtualClock;
+    }
+
+    setup();
+
+    unsigned long allocationsBefore = allocationCount.load();
+    unsigned long begin = micros();
+    unsigned long worst = 0;
+    long count = 0;
+    while ((loopCount < 0) || (count < loopCount)) {
+        unsigned long loopBegin = micros();
+        loop();
+        unsigned long loopTime = micros() - loopBegin;
+        virtualClock.advanceMicros(virtualStep);
+        if (loopTime > worst) {
+            worst = loopTime;
+        }
+        count++;
+    }
+    unsigned long total = micros() - begin;
+    unsigned long allocations = allocationCount.load() - allocationsBefore;
+
+    fflush(stdout);
+    fprintf(stderr, "loops: %ld, total: %lu us, avg: %.3f us, max: %lu us, nvs writes: %lu, nvs reads: %lu, heap allocations: %lu\n",
+        count, total, (count > 0) ? ((double) total / count) : 0.0, worst,
+        Preferences::writeCount, Preferences::readCount, allocations);
+    fprintf(stderr, "i2c transactions: %lu, i2c bytes written: %lu\n", Wire.getTransactions(), Wire.getBytesWritten());
+    if (nativeClock != NULL) {
+        fprintf(stderr, "virtual clock: %llu us\n", (unsigned long long) virtualClock.getMicros());
+    }
+    fflush(stderr);
+    //Tasks started with xTaskCreatePinnedToCore never return, skip static destructors they may still be using
+    _exit(0);
+}
@@ -50,6 +50,8 @@ extern EspSoftwareSerial::UART Serial3;
 //Stream configurations (modify to suit your needs)
 #define LOGGER_STREAM &Serial
 #define LOGGER_STREAM_SETUP Serial.begin(115200)
+#define LOGGER_STREAM_BUFFER_SIZE 10240
+#define LOGGER_STREAM_OVERFLOW BufferedStream::DROP_OLDEST    //DROP_NEWEST, DROP_OLDEST or BLOCK
 #define CONSOLE_STREAM LOGGER_STREAM
 #define CONSOLE_STREAM_SETUP
 #define DOME_STREAM &Serial3
@@ -68,6 +70,11 @@ extern EspSoftwareSerial::UART Serial3;
 #define PCA9685_OUTPUT_ENABLE_PIN 15
 #define PCA9685_OSC_FREQUENCY 25000000
 #define PCA9685_PWM_FREQ_HZ 50
+//Boards chained on the I2C bus as {address, PWM frequency}, their outputs are numbered
+//  across the boards: the first board has outputs 0-15, the second 16-31, etc.
+//  e.g. {{PCA9685_I2C_ADDRESS, PCA9685_PWM_FREQ_HZ}, {0x41, 50}, {0x42, 1000}}
+#define PCA9685_BOARDS {{PCA9685_I2C_ADDRESS, PCA9685_PWM_FREQ_HZ}}
+#define PCA9685_MAX_BOARDS 8
 
 //DomeMgr Motor config
 #define PWMSERVICE_DOME_MOTOR_OUT1 0
@@ -93,6 +100,61 @@ extern EspSoftwareSerial::UART Serial3;
 #define CONFIG_DEFAULT_PS3_MAC              "XX:XX:XX:XX:XX:XX"
 #define CONFIG_DEFAULT_PS3_ALT_MAC          "XX:XX:XX:XX:XX:XX"
 
+//Control task config (controller sampling, DriveMgr/DomeMgr and the motor drivers)
+#define CONTROL_TASK_PERIOD_MS          10
+#define CONTROL_TASK_CORE               1
+#define CONTROL_TASK_PRIORITY           5
+#define CONTROL_TASK_STACK_SIZE         8192
+
+//Config writer task config (writes Config changes to flash once they have settled)
+#define CONFIG_WRITER_CORE              0
+#define CONFIG_WRITER_PRIORITY          1
+#define CONFIG_WRITER_STACK_SIZE        4096
+#define CONFIG_WRITER_PERIOD_MS         100
+#define CONFIG_WRITE_DEBOUNCE_MS        2000    //Write once a namespace has not changed for this long
+#define CONFIG_WRITE_MAX_DELAY_MS       10000   //but never hold a change back for longer than this
+
+//Logger floors: DEBUG and INFO messages below these levels are compiled out, LogLevel can
+//  only raise a component above its floor.  Can also be set with -D build flags.
+#ifndef LOGGER_FLOOR_DEFAULT
+#define LOGGER_FLOOR_DEFAULT            DEBUG
+#endif
+#ifndef LOGGER_FLOOR_RING
+#define LOGGER_FLOOR_RING               LOGGER_FLOOR_DEFAULT    //BLE ring report dumps
+#endif
+#ifndef LOGGER_FLOOR_PCA9685
+#define LOGGER_FLOOR_PCA9685            LOGGER_FLOOR_DEFAULT    //Every PWM update
+#endif
+#ifndef LOGGER_FLOOR_ACTIONMGR
+#define LOGGER_FLOOR_ACTIONMGR          LOGGER_FLOOR_DEFAULT    //Every command parsed and sent
+#endif
+
+//Logger task config (formats and writes deferred log records)
+#define LOGGER_TASK_CORE                0
+#define LOGGER_TASK_PRIORITY            1
+#define LOGGER_TASK_STACK_SIZE          4096
+#define LOGGER_TASK_PERIOD_MS           20
+#define LOGGER_QUEUE_SIZE               32      //Records buffered before new ones are dropped
+
+//Log storm limits
+#define LOGGER_REPEAT_REPORT_MS         5000    //Report a run of identical messages at least this often
+#define LOGGER_LIMIT_TICK_MS            1000    //Messages that can repeat every tick: one per second
+#define LOGGER_LIMIT_TICK_BURST         3       //  after a burst of this many
+#define LOGGER_LIMIT_FAULT_MS           5000    //Controller fault checks: one per 5 seconds
+#define LOGGER_LIMIT_FAULT_BURST        2
+
+//TimerService config (output and command timeouts, AutoDome and random sound deadlines)
+//  Brain checks at compile time that this covers every component that creates timers
+#define TIMERSERVICE_MAX_TIMERS         8
+#define TIMERSERVICE_MAX_LANES          2       //One per Scheduler: the main loop and the control task
+
+//Scheduler periods in microseconds (modify to suit your needs)
+#define SCHEDULE_CONTROL_PERIOD_US      (CONTROL_TASK_PERIOD_MS * 1000)
+#define SCHEDULE_NORMAL_PERIOD_US       10000   //ActionMgr, AudioMgr, PWM output timeouts
+#define SCHEDULE_HOUSEKEEPING_PERIOD_US 100000  //Components with little or nothing to do in task()
+#define SCHEDULE_PANEL_PERIOD_US        20000   //Panel servo easing, one step per servo frame
+
 //Local Panel Servo Config
 #define LOCAL_PANEL_COUNT             10
 #define PWMSERVICE_PANEL_FIRST_OUT    6
+#define PANEL_MAX_ACCELERATING        3     //Panels allowed in the first half of a move at once, the rest wait their turn
@@ -43,13 +43,8 @@ namespace droid::audio {
         CmdHandler(name, system),
         audioMgr(audioMgr) {}
     
-    bool AudioCmdHandler::process(const char* device, const char* command) {
-        if ((strcasecmp(name, device) != 0) ||
-            (command == NULL)) {
-            return false;
-        }
-
-        logger->log(name, DEBUG, "AudioCmdHandler asked to process cmd: %s\n", command);
+    bool AudioCmdHandler::execute(const char* command) {
+        LOGGER_LOG(logger, logId, DEBUG, "AudioCmdHandler asked to process cmd: %s\n", command);
         return parseCmd(command);
     }
 
@@ -34,7 +34,9 @@
 namespace droid::audio {
     AudioMgr::AudioMgr(const char* name, droid::core::System* system, AudioDriver* driver) :
         BaseComponent(name, system),
-        driver(driver) {}
+        driver(driver) {
+        setSchedule(SCHEDULE_NORMAL_PERIOD_US, SCHEDULE_NORMAL_PERIOD_US / 2, SCHEDULE_PRIORITY_NORMAL);
+    }
 
     void AudioMgr::init() {
         this->volume = config->getFloat(name, CONFIG_KEY_VOLUME, CONFIG_DEFAULT_VOLUME);
@@ -44,37 +46,33 @@ namespace droid::audio {
         this->minRandomMilliSeconds = config->getInt(name, CONFIG_KEY_RANDOM_MIN, CONFIG_DEFAULT_RANDOM_MIN);
         this->maxRandomMilliSeconds = config->getInt(name, CONFIG_KEY_RANDOM_MAX, CONFIG_DEFAULT_RANDOM_MAX);
         this->cmdStaggerMs = config->getInt(name, CONFIG_KEY_CMD_STAGGER, CONFIG_DEFAULT_CMD_STAGGER);
+        randomTimer = createTimer();
 
         enableRandom(enableRandomPlay);
         setVolume(this->volume);
     }
     
     void AudioMgr::task() {
-        unsigned long currentTime = millis();
-        droid::core::Instruction* instruction = audioCmdList.initLoop();
-        while (instruction != NULL) {
-            if (currentTime >= instruction->executeTime) {
-
-                logger->log(name, DEBUG, "Executing AudioCmd: %s at time: %d\n", instruction->command, currentTime);
+        unsigned long currentTime = clock->millis();
+        droid::core::Instruction instruction;
+        while (audioCmdList.popDue(currentTime, instruction)) {
+            LOGGER_LOG(logger, logId, DEBUG, "Executing AudioCmd: %s at time: %lu\n", instruction.command, currentTime);
 
-                if (strncasecmp(AUDIO_CMD_RANDOM_ON, instruction->command, sizeof(AUDIO_CMD_RANDOM_ON)) == 0) {
-                    randomPlayEnabled = true;
-                } else if (strncasecmp(AUDIO_CMD_RANDOM_OFF, instruction->command, sizeof(AUDIO_CMD_RANDOM_OFF)) == 0) {
-                    randomPlayEnabled = false;
-                } else {
-                    bool processed = driver->executeCmd(instruction->command);
-                    if (!processed) {
-                        logger->log(name, WARN, "AudioCmd was not handled: %s\n", instruction->command);
-                    }
+            if (strncasecmp(AUDIO_CMD_RANDOM_ON, instruction.command, sizeof(AUDIO_CMD_RANDOM_ON)) == 0) {
+                randomPlayEnabled = true;
+                if (!timers->isRunning(randomTimer)) {
+                    timers->start(randomTimer, 0);
                 }
-
-                instruction = audioCmdList.deleteInstruction(instruction);
+            } else if (strncasecmp(AUDIO_CMD_RANDOM_OFF, instruction.command, sizeof(AUDIO_CMD_RANDOM_OFF)) == 0) {
+                randomPlayEnabled = false;
+                timers->cancel(randomTimer);
             } else {
-                instruction = instruction->next;
+                bool processed = driver->executeCmd(instruction.command);
+                if (!processed) {
+                    logger->log(logId, WARN, "AudioCmd was not handled: %s\n", instruction.command);
+                }
             }
         }
-
-        randomPlay();
     }
     
     void AudioMgr::factoryReset() {
@@ -89,13 +87,13 @@ namespace droid::audio {
     }
     
     void AudioMgr::logConfig() {
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_VOLUME, config->getString(name, CONFIG_KEY_VOLUME, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_MAX_VOLUME, config->getString(name, CONFIG_KEY_MAX_VOLUME, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_MIN_VOLUME, config->getString(name, CONFIG_KEY_MIN_VOLUME, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_RANDOM_ENABLED, config->getString(name, CONFIG_KEY_RANDOM_ENABLED, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_RANDOM_MIN, config->getString(name, CONFIG_KEY_RANDOM_MIN, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_RANDOM_MAX, config->getString(name, CONFIG_KEY_RANDOM_MAX, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_CMD_STAGGER, config->getString(name, CONFIG_KEY_CMD_STAGGER, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_VOLUME, config->getString(name, CONFIG_KEY_VOLUME, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_MAX_VOLUME, config->getString(name, CONFIG_KEY_MAX_VOLUME, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_MIN_VOLUME, config->getString(name, CONFIG_KEY_MIN_VOLUME, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_RANDOM_ENABLED, config->getString(name, CONFIG_KEY_RANDOM_ENABLED, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_RANDOM_MIN, config->getString(name, CONFIG_KEY_RANDOM_MIN, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_RANDOM_MAX, config->getString(name, CONFIG_KEY_RANDOM_MAX, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_CMD_STAGGER, config->getString(name, CONFIG_KEY_CMD_STAGGER, "").c_str());
     }
 
     void AudioMgr::failsafe() {
@@ -138,7 +136,7 @@ namespace droid::audio {
     }
     
     void AudioMgr::setVolume(float newVolume) {
-        logger->log(name, DEBUG, "setVolume(%f)\n", newVolume);
+        LOGGER_LOG(logger, logId, DEBUG, "setVolume(%f)\n", newVolume);
         if (newVolume < minVolume) {
             newVolume = minVolume;
         }
@@ -193,19 +191,20 @@ namespace droid::audio {
     }
     
     void AudioMgr::playSound(uint8_t bank, uint8_t sound) {
-        logger->log(name, DEBUG, "playSound(%d, %d)\n", bank, sound);
+        LOGGER_LOG(logger, logId, DEBUG, "playSound(%d, %d)\n", bank, sound);
         queueCommand(driver->getPlaySoundCmd(cmdBuffer, INSTRUCTIONLIST_COMMAND_LEN, bank, sound));
     }
     
     void AudioMgr::stop() {
-        logger->log(name, DEBUG, "stop()\n");
+        LOGGER_LOG(logger, logId, DEBUG, "stop()\n");
         audioCmdList.clear();
         randomPlayEnabled = false;
+        timers->cancel(randomTimer);
         queueCommand(driver->getStopCmd(cmdBuffer, INSTRUCTIONLIST_COMMAND_LEN));
     }
     
     void AudioMgr::enableRandom(bool enable, uint16_t secondsInFuture) {
-        logger->log(name, DEBUG, "enableRandom(%d, %d)\n", enable, secondsInFuture);
+        LOGGER_LOG(logger, logId, DEBUG, "enableRandom(%d, %d)\n", enable, secondsInFuture);
         queueCommand(driver->getEnableRandomCmd(cmdBuffer, INSTRUCTIONLIST_COMMAND_LEN, enable), (((int) secondsInFuture) * 1000));
     }
 
@@ -213,44 +212,46 @@ namespace droid::audio {
         return randomPlayEnabled;
     }
 
-    void AudioMgr::randomPlay() {
+    //Plays a random sound, then waits a random time between min and max for the next one
+    void AudioMgr::timerExpired(droid::core::TimerId timer) {
         if (randomPlayEnabled) {
-            unsigned long now = millis();
-            if (now > nextRandomTime) {
-                nextRandomTime = now + ((random() % (maxRandomMilliSeconds - minRandomMilliSeconds + 1)) + minRandomMilliSeconds);
+            timers->start(randomTimer, (random() % (maxRandomMilliSeconds - minRandomMilliSeconds + 1)) + minRandomMilliSeconds);
 
-                uint8_t bank = random(1, 5);    // Plays a random sound from the first 5 banks only
-                uint8_t sound = random(1, driver->maxSounds[bank]);
-                playSound(bank, sound);
-            }
+            uint8_t bank = random(1, 5);    // Plays a random sound from the first 5 banks only
+            uint8_t sound = random(1, driver->maxSounds[bank]);
+            playSound(bank, sound);
         }
     }
     
     void AudioMgr::queueCommand(const char* command, unsigned long delayMs) {
-        logger->log(name, DEBUG, "queueCommand(%s, %d)\n", command, delayMs);
-        droid::core::Instruction* newAudioCmd = audioCmdList.addInstruction();
-        if (newAudioCmd == NULL) {
-            logger->log(name, WARN, "Command Queue is Full.  Dropping command: %s\n", command);
-            audioCmdList.dump(name, logger, WARN);
-            return;
-        }
-        strncpy(newAudioCmd->command, command, INSTRUCTIONLIST_COMMAND_LEN);
-
-        ulong now = millis();
+        LOGGER_LOG(logger, logId, DEBUG, "queueCommand(%s, %lu)\n", command, delayMs);
+        unsigned long executeTime;
+        unsigned long scheduledCmd = lastScheduledCmd;
+        ulong now = clock->millis();
         if (delayMs != 0) {
             //Don't stagger delayed commands, just assume they will not overlap
-            newAudioCmd->executeTime = now + delayMs;
+            executeTime = now + delayMs;
         } else {
             //Ensure that commands are not scheduled to overlap each other
             if (now >= (lastScheduledCmd + cmdStaggerMs)) {
                 //Stagger not required
-                lastScheduledCmd = now;
-                newAudioCmd->executeTime = now;
+                scheduledCmd = now;
+                executeTime = now;
             } else {
                 //We need to enforce staggering of commands
-                lastScheduledCmd += cmdStaggerMs;
-                newAudioCmd->executeTime = lastScheduledCmd;
+                scheduledCmd += cmdStaggerMs;
+                executeTime = scheduledCmd;
             }
         }
+
+        droid::core::Instruction* newAudioCmd = audioCmdList.addInstruction(executeTime);
+        if (newAudioCmd == NULL) {
+            logger->log(logId, WARN, "Command Queue is Full.  Dropping command: %s\n", command);
+            audioCmdList.dump(name, logger, WARN);
+            return;
+        }
+        lastScheduledCmd = scheduledCmd;
+        strncpy(newAudioCmd->command, command, INSTRUCTIONLIST_COMMAND_LEN);
+        newAudioCmd->command[INSTRUCTIONLIST_COMMAND_LEN - 1] = 0;
     }
 }
\ No newline at end of file
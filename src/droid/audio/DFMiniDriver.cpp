@@ -21,7 +21,7 @@ namespace droid::audio {
     DFMiniDriver::DFMiniDriver(const char* name, droid::core::System* system, Stream* out) : 
         AudioDriver(name, system),
         out(out) {
-        powerOnTime = millis();
+        powerOnTime = clock->millis();
     }
 
     void DFMiniDriver::sendMsg(uint8_t command, uint8_t parm1, uint8_t parm2) {
@@ -46,12 +46,12 @@ namespace droid::audio {
     }
 
     void DFMiniDriver::init() {
-        if (millis() > powerOnTime + DFMINI_POWER_ON_DELAY) {
-            logger->log(name, DEBUG, "Attempting to reset DFPlayer\n");
+        if (clock->millis() > powerOnTime + DFMINI_POWER_ON_DELAY) {
+            LOGGER_LOG(logger, logId, DEBUG, "Attempting to reset DFPlayer\n");
             waiting = false;
             sendMsg(0x0c);
         } else {
-            logger->log(name, DEBUG, "Skipping DFPlayer init, waiting for power on delay\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Skipping DFPlayer init, waiting for power on delay\n");
         }
     }
 
@@ -83,27 +83,27 @@ namespace droid::audio {
             init();
         }
         if (waiting) {
-            logger->log(name, DEBUG, "DFPlayer.executeCmd skipping because not initialized\n");
+            LOGGER_LOG(logger, logId, DEBUG, "DFPlayer.executeCmd skipping because not initialized\n");
             return false;
         }
         switch (deviceCmd[0]) {
             case 't':
-                logger->log(name, DEBUG, "DFPlayer.playMp3Folder(%d)\n", deviceCmd[1]);
+                LOGGER_LOG(logger, logId, DEBUG, "DFPlayer.playMp3Folder(%d)\n", deviceCmd[1]);
                 sendMsg(0x12, 0x00, deviceCmd[1]);
                 break;
 
             case 'v':
-                logger->log(name, DEBUG, "DFPlayer.volume(%d)\n", deviceCmd[1]);
+                LOGGER_LOG(logger, logId, DEBUG, "DFPlayer.volume(%d)\n", deviceCmd[1]);
                 sendMsg(0x06, 0x00, deviceCmd[1]);
                 break;
 
             case 's':
-                logger->log(name, DEBUG, "DFPlayer.stop()\n");
+                LOGGER_LOG(logger, logId, DEBUG, "DFPlayer.stop()\n");
                 sendMsg(0x16);
                 break;
 
             default:
-                logger->log(name, DEBUG, "DFPlayer invalid command: %s\n", deviceCmd);
+                LOGGER_LOG(logger, logId, DEBUG, "DFPlayer invalid command: %s\n", deviceCmd);
                 return false;
         }
         return true;
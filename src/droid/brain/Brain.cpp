@@ -17,10 +17,12 @@
 #include "droid/brain/PanelCmdHandler.h"
 #include "droid/services/NoPWMService.h"
 #include "droid/services/PCA9685PWM.h"
+#ifndef MECHMIND_NATIVE
 #include "droid/controller/DualSonyNavController.h"
 #include "droid/controller/DualRingController.h"
 #include "droid/controller/PS3BtController.h"
 #include "droid/controller/PS3UsbController.h"
+#endif
 #include "droid/controller/StubController.h"
 #include "droid/motor/PWMMotorDriver.h"
 #include "droid/motor/SabertoothDriver.h"
@@ -47,87 +49,112 @@
 #define CONFIG_DEFAULT_BRAIN_TURBO_ENABLE    false
 #define CONFIG_DEFAULT_BRAIN_AUTODOME_ENABLE false
 
+//A WARN is logged (and a deadline miss counted) when these are exceeded
+#define BRAIN_COMPONENT_DEADLINE_MICROS     10000
+#define BRAIN_TASK_DEADLINE_MICROS          30000
+
+namespace {
+    const droid::services::PCA9685BoardConfig pca9685Boards[] = PCA9685_BOARDS;
+
+    //Worst case of the components Brain can create: a drive motor, a PWM dome motor, the PWM service, AudioMgr and DomeMgr
+    constexpr uint8_t MAX_TIMER_USERS =
+        ((droid::motor::PWMMotorDriver::TIMER_COUNT > droid::motor::CytronSmartDriveDuoDriver::TIMER_COUNT) ?
+            droid::motor::PWMMotorDriver::TIMER_COUNT : droid::motor::CytronSmartDriveDuoDriver::TIMER_COUNT) +
+        droid::motor::PWMMotorDriver::TIMER_COUNT +
+        droid::services::PCA9685PWM::TIMER_COUNT +
+        droid::audio::AudioMgr::TIMER_COUNT +
+        droid::brain::DomeMgr::TIMER_COUNT;
+    static_assert(TIMERSERVICE_MAX_TIMERS >= MAX_TIMER_USERS, "TIMERSERVICE_MAX_TIMERS is too small for the timers Brain's components create");
+}
+
 namespace droid::brain {
     Brain::Brain(const char* name, droid::core::System* system) : 
-        BaseComponent(name, system) {
+        BaseComponent(name, system),
+        scheduler(logger, clock, config, timers, BRAIN_COMPONENT_DEADLINE_MICROS) {
 
         //Construct optional/pluggable components
 
         String whichService = config->getString(name, CONFIG_KEY_BRAIN_PWMSERVICE, CONFIG_DEFAULT_PWMSERVICE);
-        logger->log(name, DEBUG, "Requested PWMService: %s\n", whichService);
+        LOGGER_LOG(logger, logId, DEBUG, "Requested PWMService: %s\n", whichService.c_str());
         if (whichService == PWMSERVICE_OPTION_PCA9685) {
-            logger->log(name, DEBUG, "Initializing PCA9685\n");
-            pwmService = new droid::services::PCA9685PWM("PCA9685", system, PCA9685_I2C_ADDRESS, PCA9685_OUTPUT_ENABLE_PIN);
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing PCA9685\n");
+            pwmService = new droid::services::PCA9685PWM("PCA9685", system, pca9685Boards, sizeof(pca9685Boards) / sizeof(pca9685Boards[0]), Wire, PCA9685_OUTPUT_ENABLE_PIN);
         } else {
-            logger->log(name, DEBUG, "Initializing PWMStub\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing PWMStub\n");
             pwmService = new droid::services::NoPWMService("PWMStub", system);
         }
         system->setPWMService(pwmService);
 
         whichService = config->getString(name, CONFIG_KEY_BRAIN_CONTROLLER, CONFIG_DEFAULT_CONTROLLER);
-        logger->log(name, DEBUG, "Requested Controller: %s\n", whichService);
+        LOGGER_LOG(logger, logId, DEBUG, "Requested Controller: %s\n", whichService.c_str());
+        //The Bluetooth/USB controllers need the ESP32 radio stacks, only the stub runs natively
+#ifndef MECHMIND_NATIVE
         if (whichService == CONTROLLER_OPTION_DUALRING) {
-            logger->log(name, DEBUG, "Initializing DualRing\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing DualRing\n");
             controller = new droid::controller::DualRingController(CONTROLLER_OPTION_DUALRING, system);
         } else if (whichService == CONTROLLER_OPTION_SONYNAV) {
-            logger->log(name, DEBUG, "Initializing SonyNav\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing SonyNav\n");
             controller = new droid::controller::DualSonyNavController(CONTROLLER_OPTION_SONYNAV, system);
         } else if (whichService == CONTROLLER_OPTION_PS3BT) {
-            logger->log(name, DEBUG, "Initializing PS3Bt\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing PS3Bt\n");
             controller = new droid::controller::PS3BtController(CONTROLLER_OPTION_PS3BT, system);
         } else if (whichService == CONTROLLER_OPTION_PS3USB) {
-            logger->log(name, DEBUG, "Initializing PS3Usb\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing PS3Usb\n");
             controller = new droid::controller::PS3UsbController(CONTROLLER_OPTION_PS3USB, system);
-        } else {
-            logger->log(name, DEBUG, "Initializing ControllerStub\n");
+        } else
+#endif
+        {
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing ControllerStub\n");
             controller = new droid::controller::StubController("ControllerStub", system);
         }
 
         whichService = config->getString(name, CONFIG_KEY_BRAIN_DRIVE_MOTOR, CONFIG_DEFAULT_DRIVE_MOTOR);
-        logger->log(name, DEBUG, "Requested DriveMotor: %s\n", whichService);
+        LOGGER_LOG(logger, logId, DEBUG, "Requested DriveMotor: %s\n", whichService.c_str());
         if (whichService == MOTOR_DRIVER_OPTION_SABERTOOTH) {
-            logger->log(name, DEBUG, "Initializing Drive Sabertooth\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing Drive Sabertooth\n");
             driveMotorDriver = new droid::motor::SabertoothDriver("DriveSaber", system, (byte) 128, SABERTOOTH_STREAM);
         } else if (whichService == MOTOR_DRIVER_OPTION_CYTRON) {
-            logger->log(name, DEBUG, "Initializing DriveCytron\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing DriveCytron\n");
             driveMotorDriver = new droid::motor::CytronSmartDriveDuoMDDS30Driver("DriveCytron", system, (byte) 128, CYTRON_STREAM);
         } else if (whichService == MOTOR_DRIVER_OPTION_PWMMOTOR) {
-            logger->log(name, DEBUG, "Initializing DrivePWM\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing DrivePWM\n");
             driveMotorDriver = new droid::motor::PWMMotorDriver("DrivePWM", system, PWMSERVICE_DRIVE_MOTOR0_OUT1, PWMSERVICE_DRIVE_MOTOR0_OUT2, PWMSERVICE_DRIVE_MOTOR1_OUT1, PWMSERVICE_DRIVE_MOTOR1_OUT2);
         } else {
-            logger->log(name, DEBUG, "Initializing DriveStub\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing DriveStub\n");
             driveMotorDriver = new droid::motor::StubMotorDriver("DriveStub", system);
         }
 
         whichService = config->getString(name, CONFIG_KEY_BRAIN_DOME_MOTOR, CONFIG_DEFAULT_DOME_MOTOR);
-        logger->log(name, DEBUG, "Requested DomeMotor: %s\n", whichService);
+        LOGGER_LOG(logger, logId, DEBUG, "Requested DomeMotor: %s\n", whichService.c_str());
         if (whichService == MOTOR_DRIVER_OPTION_PWMMOTOR) {
-            logger->log(name, DEBUG, "Initializing DomePWM\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing DomePWM\n");
             domeMotorDriver = new droid::motor::PWMMotorDriver("DomePWM", system, PWMSERVICE_DOME_MOTOR_OUT1, PWMSERVICE_DOME_MOTOR_OUT2, -1, -1);
         } else {
-            logger->log(name, DEBUG, "Initializing DomeStub\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing DomeStub\n");
             domeMotorDriver = new droid::motor::StubMotorDriver("DomeStub", system);
         }
 
         whichService = config->getString(name, CONFIG_KEY_BRAIN_AUDIO_DRIVER, CONFIG_DEFAULT_AUDIO_DRIVER);
-        logger->log(name, DEBUG, "Requested AudioDriver: %s\n", whichService);
+        LOGGER_LOG(logger, logId, DEBUG, "Requested AudioDriver: %s\n", whichService.c_str());
         if (whichService == AUDIO_DRIVER_OPTION_HCR) {
-            logger->log(name, DEBUG, "Initializing HCRDriver\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing HCRDriver\n");
             audioDriver = new droid::audio::HCRDriver("HCRDriver", system, AUDIO_STREAM);
         } else if (whichService == AUDIO_DRIVER_OPTION_DFMINI) {
-            logger->log(name, DEBUG, "Initializing DFMiniDriver\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing DFMiniDriver\n");
             audioDriver = new droid::audio::DFMiniDriver("DFMiniDriver", system, AUDIO_STREAM);
         } else if (whichService == AUDIO_DRIVER_OPTION_SPARKFUN) {
-            logger->log(name, DEBUG, "Initializing SparkDriver\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing SparkDriver\n");
             audioDriver = new droid::audio::SparkDriver("SparkDriver", system, AUDIO_STREAM);
         } else {
-            logger->log(name, DEBUG, "Initializing AudioStub\n");
+            LOGGER_LOG(logger, logId, DEBUG, "Initializing AudioStub\n");
             audioDriver = new droid::audio::StubAudioDriver("AudioStub", system);
         }
 
         domeMgr = new droid::brain::DomeMgr("DomeMgr", system, controller, domeMotorDriver);
         driveMgr = new droid::brain::DriveMgr("DriveMgr", system, controller, driveMotorDriver);
-        actionMgr = new droid::command::ActionMgr("ActionMgr", system, controller);
+        controlLoop = new droid::brain::ControlLoop("Control", system, controller, CONTROL_TASK_PERIOD_MS);
+        //ActionMgr runs on the main loop, so it reads the controller through the control loop's snapshot
+        actionMgr = new droid::command::ActionMgr("ActionMgr", system, controlLoop->getSnapshotController());
         audioMgr = new droid::audio::AudioMgr("AudioMgr", system, audioDriver);
 
 
@@ -152,12 +179,28 @@ namespace droid::brain {
         componentList.push_back(audioDriver);
         componentList.push_back(actionMgr);
         componentList.push_back(panelCmdHandler);
+
+        //Controller sampling, the Managers and the motor drivers run on the control task.
+        //  So does the PWMService, the control task is the only one writing to the I2C bus.
+        controlLoop->add(controller);
+        controlLoop->add(domeMgr);
+        controlLoop->add(driveMgr);
+        controlLoop->add(domeMotorDriver);
+        controlLoop->add(driveMotorDriver);
+        controlLoop->add(pwmService);
+
+        //Everything else is run from the main loop, according to each component's Schedule
+        scheduler.add(audioMgr);
+        scheduler.add(audioDriver);
+        scheduler.add(actionMgr);
+        scheduler.add(panelCmdHandler);
+        loopStats.setDeadline(BRAIN_TASK_DEADLINE_MICROS);
     }
 
     void Brain::init() {
         bool initialized = config->getBool(name, CONFIG_KEY_BRAIN_INITIALIZED, false);
         if (!initialized) {
-            logger->log(name, INFO, "Brain has not been initialized, performing a factory reset.");
+            LOGGER_LOG(logger, logId, INFO, "Brain has not been initialized, performing a factory reset.");
             factoryReset();
         }
         droidState->stickEnable = config->getBool(name, CONFIG_KEY_BRAIN_STICK_ENABLE, CONFIG_DEFAULT_BRAIN_STICK_ENABLE);
@@ -172,6 +215,15 @@ namespace droid::brain {
         for (droid::core::BaseComponent* component : componentList) {
             component->init();
         }
+        config->flush();
+        config->start(CONFIG_WRITER_CORE, CONFIG_WRITER_PRIORITY, CONFIG_WRITER_STACK_SIZE);
+        scheduler.start();
+    }
+
+    //Not part of init(): until the Logger is deferred every log() waits on the serial output,
+    //  which would stall the control task behind the main loop's startup logging
+    void Brain::start() {
+        controlLoop->start(CONTROL_TASK_CORE, CONTROL_TASK_PRIORITY, CONTROL_TASK_STACK_SIZE);
     }
 
     void Brain::factoryReset() {
@@ -186,6 +238,7 @@ namespace droid::brain {
         config->putBool(name, CONFIG_KEY_BRAIN_AUTODOME_ENABLE, CONFIG_DEFAULT_BRAIN_AUTODOME_ENABLE);
 
         //The Controllers are special because they cannot be instantiated twice
+#ifndef MECHMIND_NATIVE
         if (controller->getType() == droid::controller::Controller::ControllerType::DUAL_RING) {
             controller->factoryReset();
         } else {
@@ -216,6 +269,7 @@ namespace droid::brain {
             ps3Controller->init();
             ps3Controller->factoryReset();
         }
+#endif
         if (controller->getType() == droid::controller::Controller::ControllerType::STUB) {
             controller->factoryReset();
         } else {
@@ -250,13 +304,17 @@ namespace droid::brain {
     }
 
     void Brain::failsafe() {
-        for (droid::core::BaseComponent* component : componentList) {
-            component->failsafe();
+        //The control components are failsafed by the control task on its next tick
+        controlLoop->requestFailsafe();
+        for (size_t i = 0; i < scheduler.size(); i++) {
+            scheduler.getTask(i).component->failsafe();
         }
     }
 
     void Brain::reboot() {
-        logger->log(name, WARN, "System Restarting...\n");
+        logger->log(logId, WARN, "System Restarting...\n");
+        config->flush();
+        logger->flush();
         sleep(2);
         ESP.restart();
     }
@@ -294,7 +352,7 @@ namespace droid::brain {
                 //end of input
                 if (bufIndex > 1) {     //Skip empty commands
                     inputBuf[bufIndex - 1] = 0;
-                    actionMgr->queueCommand("Brain", inputBuf, millis());
+                    actionMgr->queueCommand("Brain", inputBuf, clock->millis());
                 }
                 bufIndex = 0;
             }
@@ -302,39 +360,76 @@ namespace droid::brain {
     }
 
     void Brain::task() {
-        unsigned long begin = millis();
+        unsigned long begin = micros();
+        if (statsSince == 0) {
+            statsSince = clock->millis();
+        }
         if (CONSOLE_STREAM != NULL) {
             processConsoleInput(CONSOLE_STREAM);
         }
-        for (droid::core::BaseComponent* component : componentList) {
-            unsigned long compBegin = millis();
-            component->task();
-            unsigned long compTime = millis() - compBegin;
-            if (compTime > 10) {
-                logger->log(component->name, WARN, "subTask took %d millis to execute!\n", compTime);
-            }
-        }
+        controlLoop->poll();
+        scheduler.run();
+        config->poll();
+        logger->poll();
 
         if (logger->getMaxLevel() >= ERROR) {
             failsafe();
             logger->clear();
         }
-        unsigned long time = millis() - begin;
-        if (time > 30) {
-            logger->log(name, WARN, "Task took %d millis to execute!\n", time);
+        unsigned long time = micros() - begin;
+        loopStats.record(time);
+        if (time > BRAIN_TASK_DEADLINE_MICROS) {
+            logger->log(logId, WARN, "Task took %lu micros to execute!\n", time);
+        }
+    }
+
+    void Brain::printStats(Print* out) {
+        if (out == NULL) {
+            return;
+        }
+        unsigned long elapsed = clock->millis() - statsSince;
+        uint32_t loops = loopStats.getCount();
+        out->printf("\nTask timing (micros) over %lu millis, %lu loops/sec\n", elapsed, 
+            (elapsed > 0) ? (unsigned long) (((uint64_t) loops * 1000) / elapsed) : 0UL);
+        out->printf("  %-16s %8s %4s %10s %8s %8s %8s %8s %8s %8s\n", "Component", "Period", "Prio", "Count", "Mean", "p50", "p99", "Max", "Misses", "Overruns");
+        const droid::core::Scheduler& controlScheduler = controlLoop->getScheduler();
+        for (size_t i = 0; i < controlScheduler.size(); i++) {
+            const droid::core::ScheduledTask& task = controlScheduler.getTask(i);
+            printStatsLine(out, task.component->name, task.schedule.periodMicros, task.schedule.priority, task.stats, task.overruns);
         }
+        printStatsLine(out, "ControlTick", CONTROL_TASK_PERIOD_MS * 1000, 0, controlLoop->getTickStats(), 0);
+        printStatsLine(out, "ControlJitter", CONTROL_TASK_PERIOD_MS * 1000, 0, controlLoop->getJitterStats(), 0);
+        for (size_t i = 0; i < scheduler.size(); i++) {
+            const droid::core::ScheduledTask& task = scheduler.getTask(i);
+            printStatsLine(out, task.component->name, task.schedule.periodMicros, task.schedule.priority, task.stats, task.overruns);
+        }
+        printStatsLine(out, "Loop", 0, 0, loopStats, 0);
+    }
+
+    void Brain::printStatsLine(Print* out, const char* label, uint32_t period, uint8_t priority, const droid::core::TaskStats& stats, uint32_t overruns) {
+        out->printf("  %-16s %8lu %4d %10lu %8lu %8lu %8lu %8lu %8lu %8lu\n", label, (unsigned long) period, priority,
+            (unsigned long) stats.getCount(), (unsigned long) stats.getMean(),
+            (unsigned long) stats.getPercentile(50), (unsigned long) stats.getPercentile(99),
+            (unsigned long) stats.getMax(), (unsigned long) stats.getDeadlineMisses(), (unsigned long) overruns);
+    }
+
+    void Brain::resetStats() {
+        controlLoop->resetStats();
+        scheduler.resetStats();
+        loopStats.reset();
+        statsSince = clock->millis();
     }
 
     void Brain::logConfig() {
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_INITIALIZED, config->getString(name, CONFIG_KEY_BRAIN_INITIALIZED, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_CONTROLLER, config->getString(name, CONFIG_KEY_BRAIN_CONTROLLER, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_PWMSERVICE, config->getString(name, CONFIG_KEY_BRAIN_PWMSERVICE, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_DRIVE_MOTOR, config->getString(name, CONFIG_KEY_BRAIN_DRIVE_MOTOR, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_DOME_MOTOR, config->getString(name, CONFIG_KEY_BRAIN_DOME_MOTOR, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_AUDIO_DRIVER, config->getString(name, CONFIG_KEY_BRAIN_AUDIO_DRIVER, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_STICK_ENABLE, config->getString(name, CONFIG_KEY_BRAIN_STICK_ENABLE, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_TURBO_ENABLE, config->getString(name, CONFIG_KEY_BRAIN_TURBO_ENABLE, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_AUTODOME_ENABLE, config->getString(name, CONFIG_KEY_BRAIN_AUTODOME_ENABLE, ""));
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_INITIALIZED, config->getString(name, CONFIG_KEY_BRAIN_INITIALIZED, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_CONTROLLER, config->getString(name, CONFIG_KEY_BRAIN_CONTROLLER, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_PWMSERVICE, config->getString(name, CONFIG_KEY_BRAIN_PWMSERVICE, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_DRIVE_MOTOR, config->getString(name, CONFIG_KEY_BRAIN_DRIVE_MOTOR, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_DOME_MOTOR, config->getString(name, CONFIG_KEY_BRAIN_DOME_MOTOR, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_AUDIO_DRIVER, config->getString(name, CONFIG_KEY_BRAIN_AUDIO_DRIVER, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_STICK_ENABLE, config->getString(name, CONFIG_KEY_BRAIN_STICK_ENABLE, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_TURBO_ENABLE, config->getString(name, CONFIG_KEY_BRAIN_TURBO_ENABLE, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_BRAIN_AUTODOME_ENABLE, config->getString(name, CONFIG_KEY_BRAIN_AUTODOME_ENABLE, "").c_str());
         for (droid::core::BaseComponent* component : componentList) {
             component->logConfig();
         }
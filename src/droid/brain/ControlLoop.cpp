@@ -0,0 +1,127 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include "droid/brain/ControlLoop.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+//A WARN is logged (and a deadline miss counted) when a single component exceeds this
+#define CONTROLLOOP_COMPONENT_DEADLINE_MICROS   5000
+
+namespace droid::brain {
+    ControlLoop::ControlLoop(const char* name, droid::core::System* system, droid::controller::Controller* controller, uint32_t periodMs) :
+        name(name),
+        logger(system->getLogger()),
+        clock(system->getClock()),
+        controller(controller),
+        scheduler(system->getLogger(), system->getClock(), system->getConfig(), system->getTimers(), CONTROLLOOP_COMPONENT_DEADLINE_MICROS),
+        periodMicros(periodMs * 1000) {
+
+        snapshotController = new droid::controller::SnapshotController("CtrlSnapshot", system, &snapshot, controller->getType());
+        tickStats.setDeadline(periodMicros);
+    }
+
+    void ControlLoop::add(droid::core::BaseComponent* component) {
+        scheduler.add(component);
+        components.push_back(component);
+    }
+
+    //nextTick belongs to whichever runs the ticks: run() on the control task, or poll() when
+    //  there is no task, so it is only set here when the task is not started
+    bool ControlLoop::start(uint8_t core, uint8_t priority, uint32_t stackSize) {
+        uint32_t now = clock->micros();
+        scheduler.start(now);
+        if (!clock->isRealTime()) {
+            //A task sleeping on FreeRTOS ticks cannot follow a virtual clock
+            LOGGER_LOG(logger, name, INFO, "Clock is not real time, running control loop from the main loop\n");
+            taskRunning = false;
+            nextTick = now;
+            return false;
+        }
+        BaseType_t result = xTaskCreatePinnedToCore(taskEntry, name, stackSize, this, priority, NULL, core);
+        taskRunning = (result == pdPASS);
+        if (taskRunning) {
+            LOGGER_LOG(logger, name, INFO, "Control task started on core %d, period %lu micros\n", core, (unsigned long) periodMicros);
+        } else {
+            nextTick = now;
+            logger->log(name, WARN, "Unable to start control task, running control loop from the main loop\n");
+        }
+        return taskRunning;
+    }
+
+    void ControlLoop::poll() {
+        //Only used when the control task is not running
+        if (taskRunning) {
+            return;
+        }
+        uint32_t now = clock->micros();
+        if ((int32_t) (now - nextTick) >= 0) {
+            jitterStats.record(now - nextTick);
+            tick(nextTick);
+            nextTick += periodMicros;
+            if ((int32_t) (now - nextTick) >= 0) {
+                nextTick = now + periodMicros;
+            }
+        }
+    }
+
+    void ControlLoop::requestFailsafe() {
+        failsafeRequested = true;
+    }
+
+    void ControlLoop::resetStats() {
+        scheduler.resetStats();
+        tickStats.reset();
+        jitterStats.reset();
+    }
+
+    void ControlLoop::taskEntry(void* param) {
+        ((ControlLoop*) param)->run();
+    }
+
+    void ControlLoop::run() {
+        const TickType_t period = pdMS_TO_TICKS(periodMicros / 1000);
+        TickType_t lastWake = xTaskGetTickCount();
+        nextTick = clock->micros();
+        while (true) {
+            uint32_t now = clock->micros();
+            if ((int32_t) (now - nextTick) >= 0) {
+                jitterStats.record(now - nextTick);
+            } else {
+                jitterStats.record(0);
+            }
+            //Components are scheduled against the ideal tick time so period jitter never skips them
+            tick(nextTick);
+            nextTick += periodMicros;
+            if (xTaskDelayUntil(&lastWake, period) == pdFALSE) {
+                //Overran the period, resynchronize instead of running back to back ticks
+                lastWake = xTaskGetTickCount();
+                nextTick = clock->micros();
+            }
+        }
+    }
+
+    void ControlLoop::tick(uint32_t tickTime) {
+        uint32_t begin = micros();
+        if (failsafeRequested.exchange(false)) {
+            for (droid::core::BaseComponent* component : components) {
+                component->failsafe();
+            }
+        }
+        scheduler.run(tickTime);
+        publish();
+        tickStats.record(micros() - begin);
+    }
+
+    void ControlLoop::publish() {
+        //The Controller sampled its inputs during this tick, share that same sample
+        snapshot.write(controller->getInput());
+    }
+}
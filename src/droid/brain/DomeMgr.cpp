@@ -88,9 +88,23 @@ namespace droid::brain {
     DomeMgr::DomeMgr(const char* name, droid::core::System* system, droid::controller::Controller* controller, droid::motor::MotorDriver* domeMotor) : 
         BaseComponent(name, system),
         controller(controller),
-        domeMotor(domeMotor) {}
+        domeMotor(domeMotor) {
+        setSchedule(SCHEDULE_CONTROL_PERIOD_US, 0, SCHEDULE_PRIORITY_CONTROL);
+    }
 
     void DomeMgr::init() {
+        loadConfig();
+        config->subscribe(name, NULL, this);
+        autoDomeTimer = createTimer();
+        autoDomeActive = false;
+    }
+
+    void DomeMgr::configChanged(const char* nspace, const char* key) {
+        loadConfig();
+        LOGGER_LOG(logger, logId, INFO, "Config reloaded\n");
+    }
+
+    void DomeMgr::loadConfig() {
         speed = config->getInt(name, CONFIG_KEY_DOMEMGR_SPEED, CONFIG_DEFAULT_DOMEMGR_SPEED);
         rotationTimeMs = config->getInt(name, CONFIG_KEY_DOMEMGR_360TIME, CONFIG_DEFAULT_DOMEMGR_360TIME);
         deadband = config->getInt(name, CONFIG_KEY_DOMEMGR_DEADBAND, CONFIG_DEFAULT_DOMEMGR_DEADBAND);
@@ -101,8 +115,6 @@ namespace droid::brain {
         autoMaxDelayMs = config->getInt(name, CONFIG_KEY_DOMEMGR_AUTODOME_MAX_DELAY, CONFIG_DEFAULT_DOMEMGR_AUTODOME_MAX_DELAY);
         // autoAudio = config->getBool(name, CONFIG_KEY_DOMEMGR_AUTODOME_AUDIO, CONFIG_DEFAULT_DOMEMGR_AUTODOME_AUDIO);
         // autoLights = config->getBool(name, CONFIG_KEY_DOMEMGR_AUTODOME_LIGHTS, CONFIG_DEFAULT_DOMEMGR_AUTODOME_LIGHTS);
-
-        autoDomeActive = false;
     }
 
     void DomeMgr::factoryReset() {
@@ -120,16 +132,16 @@ namespace droid::brain {
     }
 
     void DomeMgr::logConfig() {
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_SPEED, config->getString(name, CONFIG_KEY_DOMEMGR_SPEED, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_360TIME, config->getString(name, CONFIG_KEY_DOMEMGR_360TIME, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_DEADBAND, config->getString(name, CONFIG_KEY_DOMEMGR_DEADBAND, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_ENABLE, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_ENABLE, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_MIN_SPEED, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_MIN_SPEED, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_MAX_SPEED, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_MAX_SPEED, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_MIN_DELAY, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_MIN_DELAY, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_MAX_DELAY, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_MAX_DELAY, "").c_str());
-        // logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_AUDIO, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_AUDIO, "").c_str());
-        // logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_LIGHTS, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_LIGHTS, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_SPEED, config->getString(name, CONFIG_KEY_DOMEMGR_SPEED, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_360TIME, config->getString(name, CONFIG_KEY_DOMEMGR_360TIME, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_DEADBAND, config->getString(name, CONFIG_KEY_DOMEMGR_DEADBAND, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_ENABLE, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_ENABLE, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_MIN_SPEED, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_MIN_SPEED, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_MAX_SPEED, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_MAX_SPEED, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_MIN_DELAY, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_MIN_DELAY, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_MAX_DELAY, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_MAX_DELAY, "").c_str());
+        // LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_AUDIO, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_AUDIO, "").c_str());
+        // LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DOMEMGR_AUTODOME_LIGHTS, config->getString(name, CONFIG_KEY_DOMEMGR_AUTODOME_LIGHTS, "").c_str());
     }
 
     void DomeMgr::failsafe() {
@@ -137,7 +149,8 @@ namespace droid::brain {
     }
 
     void DomeMgr::task() {
-        int8_t joyX = controller->getJoystickPosition(droid::controller::Controller::Joystick::LEFT, droid::controller::Controller::Axis::X);
+        droid::controller::InputSnapshot input = controller->getInput();
+        int8_t joyX = input.joystick[droid::controller::Controller::Joystick::LEFT][droid::controller::Controller::Axis::X];
         if (abs(joyX) <= deadband) {
             joyX = 0;
         }
@@ -148,7 +161,9 @@ namespace droid::brain {
             domeMotor->setMotorSpeed(0, joyX);
             //Disable autoDome
             droidState->autoDomeEnable = false;
-            autoDomeActive = false;
+            if (autoDomeActive) {
+                deactivateAutoDome();
+            }
         } else {
             bool moved = doAutoDome();
             if (!moved) {
@@ -158,57 +173,62 @@ namespace droid::brain {
     }
 
     bool DomeMgr::doAutoDome() {
-        unsigned long now = millis();
-
         if (autoEnabled &&
             !autoDomeActive &&
             droidState->autoDomeEnable) {
             autoDomeActive = true;
-            logger->log(name, DEBUG, "AutoDome activating\n");
+            //First move right away, timerExpired() takes it from there
+            timers->start(autoDomeTimer, 0);
+            LOGGER_LOG(logger, logId, DEBUG, "AutoDome activating\n");
         }
 
         if (autoDomeActive &&
             !droidState->autoDomeEnable) {
-            autoDomeActive = false;
-            autoDomeMoving = false;
-            autoDomeSpeed = 0;
-            logger->log(name, DEBUG, "AutoDome deactivating\n");
+            deactivateAutoDome();
+            LOGGER_LOG(logger, logId, DEBUG, "AutoDome deactivating\n");
         }
 
-        if (autoDomeActive) {
-            if (autoDomeMoving &&
-                (now >= autoDomeNextStop)) {
-                autoDomeMoving = false;
-                autoDomeSpeed = 0;
-                logger->log(name, DEBUG, "AutoDome should have reached desired position, stopping\n");
-            } else if (now >= autoDomeNextMove) {
-                //Choose new position and speed
-                int16_t newDomeAngle = pickNewAngle(autoDomeAngle, -160, 160);
-                autoDomeSpeed = randomBetween(autoMinSpeed, autoMaxSpeed);
-                //Determine how long it will take to get there
-                int16_t timeToEndAngle = calcTimeToAngle(autoDomeAngle, newDomeAngle, autoDomeSpeed, 1.0f, rotationTimeMs, speed);
-                if (timeToEndAngle < 0) {   //Moving in the negative direction
-                    autoDomeSpeed = -autoDomeSpeed;
-                    timeToEndAngle = -timeToEndAngle;
-                }
-                autoDomeNextStop = now + timeToEndAngle;
-                //Choose time for next move
-                autoDomeNextMove = autoDomeNextStop + randomBetween(autoMinDelayMs, autoMaxDelayMs);
-                //Begin moving to new position
-                logger->log(name, DEBUG, "AutoDome updating position, was: %d, new target: %d, speed: %d\n", autoDomeAngle, newDomeAngle, autoDomeSpeed);
-                autoDomeAngle = newDomeAngle;
-                autoDomeMoving = true;
-            }
+        if (autoDomeActive && autoDomeMoving) {
+            domeMotor->setMotorSpeed(0, autoDomeSpeed);
+            return true;
         } else {
-            autoDomeMoving = false;
-            autoDomeSpeed = 0;
+            return false;
         }
+    }
+
+    void DomeMgr::deactivateAutoDome() {
+        timers->cancel(autoDomeTimer);
+        autoDomeActive = false;
+        autoDomeMoving = false;
+        autoDomeSpeed = 0;
+    }
 
+    //The AutoDome timer alternates between the end of a move and the start of the next one
+    void DomeMgr::timerExpired(droid::core::TimerId timer) {
+        if (!autoDomeActive) {
+            return;
+        }
         if (autoDomeMoving) {
-            domeMotor->setMotorSpeed(0, autoDomeSpeed);
-            return true;
+            autoDomeMoving = false;
+            autoDomeSpeed = 0;
+            LOGGER_LOG(logger, logId, DEBUG, "AutoDome should have reached desired position, stopping\n");
+            //Choose time for next move
+            timers->start(autoDomeTimer, randomBetween(autoMinDelayMs, autoMaxDelayMs));
         } else {
-            return false;
+            //Choose new position and speed
+            int16_t newDomeAngle = pickNewAngle(autoDomeAngle, -160, 160);
+            autoDomeSpeed = randomBetween(autoMinSpeed, autoMaxSpeed);
+            //Determine how long it will take to get there
+            int16_t timeToEndAngle = calcTimeToAngle(autoDomeAngle, newDomeAngle, autoDomeSpeed, 1.0f, rotationTimeMs, speed);
+            if (timeToEndAngle < 0) {   //Moving in the negative direction
+                autoDomeSpeed = -autoDomeSpeed;
+                timeToEndAngle = -timeToEndAngle;
+            }
+            //Begin moving to new position
+            LOGGER_LOG(logger, logId, DEBUG, "AutoDome updating position, was: %d, new target: %d, speed: %d\n", autoDomeAngle, newDomeAngle, autoDomeSpeed);
+            autoDomeAngle = newDomeAngle;
+            autoDomeMoving = true;
+            timers->start(autoDomeTimer, timeToEndAngle);
         }
     }
 }
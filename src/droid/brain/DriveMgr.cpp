@@ -14,11 +14,13 @@
 #define CONFIG_KEY_DRIVEMGR_TURBOSPEED      "TurboSpeed"
 #define CONFIG_KEY_DRIVEMGR_TURNSPEED       "TurnSpeed"
 #define CONFIG_KEY_DRIVEMGR_DEADBAND        "Deadband"
+#define CONFIG_KEY_DRIVEMGR_DRIVEMODE       "DriveMode"
 
 #define CONFIG_DEFAULT_DRIVEMGR_NORMALSPEED  90
 #define CONFIG_DEFAULT_DRIVEMGR_TURBOSPEED   100
 #define CONFIG_DEFAULT_DRIVEMGR_TURNSPEED    70
 #define CONFIG_DEFAULT_DRIVEMGR_DEADBAND     16
+#define CONFIG_DEFAULT_DRIVEMGR_DRIVEMODE    droid::motor::MotorMixer::ARCADE   //0=Arcade, 1=Tank, 2=Curvature
 
 
 namespace {
@@ -34,13 +36,30 @@ namespace droid::brain {
     DriveMgr::DriveMgr(const char* name, droid::core::System* system, droid::controller::Controller* controller, droid::motor::MotorDriver* driveMotor) : 
         BaseComponent(name, system),
         controller(controller),
-        driveMotor(driveMotor) {}
+        driveMotor(driveMotor) {
+        setSchedule(SCHEDULE_CONTROL_PERIOD_US, 0, SCHEDULE_PRIORITY_CONTROL);
+    }
 
     void DriveMgr::init() {
+        loadConfig();
+        config->subscribe(name, NULL, this);
+    }
+
+    void DriveMgr::configChanged(const char* nspace, const char* key) {
+        loadConfig();
+        LOGGER_LOG(logger, logId, INFO, "Config reloaded\n");
+    }
+
+    void DriveMgr::loadConfig() {
         normalSpeed = config->getInt(name, CONFIG_KEY_DRIVEMGR_NORMALSPEED, CONFIG_DEFAULT_DRIVEMGR_NORMALSPEED);
         turboSpeed = config->getInt(name, CONFIG_KEY_DRIVEMGR_TURBOSPEED, CONFIG_DEFAULT_DRIVEMGR_TURBOSPEED);
         turnSpeed = config->getInt(name, CONFIG_KEY_DRIVEMGR_TURNSPEED, CONFIG_DEFAULT_DRIVEMGR_TURNSPEED);
         deadband = config->getInt(name, CONFIG_KEY_DRIVEMGR_DEADBAND, CONFIG_DEFAULT_DRIVEMGR_DEADBAND);
+        int mode = config->getInt(name, CONFIG_KEY_DRIVEMGR_DRIVEMODE, CONFIG_DEFAULT_DRIVEMGR_DRIVEMODE);
+        if ((mode < droid::motor::MotorMixer::ARCADE) || (mode > droid::motor::MotorMixer::CURVATURE)) {
+            mode = CONFIG_DEFAULT_DRIVEMGR_DRIVEMODE;
+        }
+        driveMode = (droid::motor::MotorMixer::Mode) mode;
     }
 
     void DriveMgr::factoryReset() {
@@ -49,19 +68,25 @@ namespace droid::brain {
         config->putInt(name, CONFIG_KEY_DRIVEMGR_TURBOSPEED, CONFIG_DEFAULT_DRIVEMGR_TURBOSPEED);
         config->putInt(name, CONFIG_KEY_DRIVEMGR_TURNSPEED, CONFIG_DEFAULT_DRIVEMGR_TURNSPEED);
         config->putInt(name, CONFIG_KEY_DRIVEMGR_DEADBAND, CONFIG_DEFAULT_DRIVEMGR_DEADBAND);
+        config->putInt(name, CONFIG_KEY_DRIVEMGR_DRIVEMODE, CONFIG_DEFAULT_DRIVEMGR_DRIVEMODE);
     }
 
     void DriveMgr::logConfig() {
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DRIVEMGR_NORMALSPEED, config->getString(name, CONFIG_KEY_DRIVEMGR_NORMALSPEED, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DRIVEMGR_TURBOSPEED, config->getString(name, CONFIG_KEY_DRIVEMGR_TURBOSPEED, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DRIVEMGR_TURNSPEED, config->getString(name, CONFIG_KEY_DRIVEMGR_TURNSPEED, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_DRIVEMGR_DEADBAND, config->getString(name, CONFIG_KEY_DRIVEMGR_DEADBAND, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DRIVEMGR_NORMALSPEED, config->getString(name, CONFIG_KEY_DRIVEMGR_NORMALSPEED, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DRIVEMGR_TURBOSPEED, config->getString(name, CONFIG_KEY_DRIVEMGR_TURBOSPEED, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DRIVEMGR_TURNSPEED, config->getString(name, CONFIG_KEY_DRIVEMGR_TURNSPEED, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DRIVEMGR_DEADBAND, config->getString(name, CONFIG_KEY_DRIVEMGR_DEADBAND, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_DRIVEMGR_DRIVEMODE, config->getString(name, CONFIG_KEY_DRIVEMGR_DRIVEMODE, "").c_str());
     }
 
     void DriveMgr::task() {
-        unsigned long begin = millis();
-        int8_t joyX = controller->getJoystickPosition(droid::controller::Controller::Joystick::RIGHT, droid::controller::Controller::Axis::X);
-        int8_t joyY = controller->getJoystickPosition(droid::controller::Controller::Joystick::RIGHT, droid::controller::Controller::Axis::Y);
+        droid::controller::InputSnapshot input = controller->getInput();
+        int8_t joyX = input.joystick[droid::controller::Controller::Joystick::RIGHT][droid::controller::Controller::Axis::X];
+        int8_t joyY = input.joystick[droid::controller::Controller::Joystick::RIGHT][droid::controller::Controller::Axis::Y];
+        if (driveMode == droid::motor::MotorMixer::TANK) {
+            //Each stick drives the motor on its side
+            joyX = input.joystick[droid::controller::Controller::Joystick::LEFT][droid::controller::Controller::Axis::Y];
+        }
         if (!droidState->stickEnable) {
             joyX = 0;
             joyY = 0;
@@ -72,14 +97,15 @@ namespace droid::brain {
         if (abs(joyY) <= deadband) {
             joyY = 0;
         }
-        if (droidState->turboSpeed) {
-            joyX = scale(joyX, -turboSpeed, turboSpeed);
+        int8_t speed = droidState->turboSpeed ? turboSpeed : normalSpeed;
+        joyX = scale(joyX, -speed, speed);
+        if (driveMode == droid::motor::MotorMixer::TANK) {
+            joyY = scale(joyY, -speed, speed);
         } else {
-            joyX = scale(joyX, -normalSpeed, normalSpeed);
+            joyY = scale(joyY, -turnSpeed, turnSpeed);
         }
-        joyY = scale(joyY, -turnSpeed, turnSpeed);
         controller->setCritical((abs(joyX) > 0) || (abs(joyY) > 0));
-        driveMotor->arcadeDrive(joyX, joyY);
+        driveMotor->drive(driveMode, joyX, joyY);
     }
 
     void DriveMgr::failsafe() {
@@ -81,16 +81,15 @@ namespace droid::brain {
         console(console),
         brain(brain) {}
 
-    bool LocalCmdHandler::process(const char* device, const char* command) {
+    bool LocalCmdHandler::execute(const char* command) {
         char cmd[ACTION_MAX_SEQUENCE_LEN] = {0};
         char parm1[ACTION_MAX_SEQUENCE_LEN] = {0};
         char parm2[ACTION_MAX_SEQUENCE_LEN] = {0};
         char parm2a[ACTION_MAX_SEQUENCE_LEN] = {0};
         char parm3[ACTION_MAX_SEQUENCE_LEN] = {0};
 
-        if ((strcasecmp(name, device) == 0) &&
-            (command != NULL)) {
-            logger->log(name, DEBUG, "LocalCmdHandler asked to processcommand: %s\n", command);
+        if (command != NULL) {
+            LOGGER_LOG(logger, logId, DEBUG, "LocalCmdHandler asked to processcommand: %s\n", command);
             parseCmd(command, cmd, sizeof(cmd), parm1, sizeof(parm1), parm2, sizeof(parm2));
             if (strcasecmp(cmd, "StickEnable") == 0) {
                 droidState->stickEnable = true;
@@ -162,7 +161,7 @@ namespace droid::brain {
 
             } else if (strcasecmp(cmd, "FactoryReset") == 0) {
                 //Delete all preferences, reset button actions to sketch defaults, unpair controllers.
-                logger->log(name, WARN, "Initiating factory reset...\n");
+                logger->log(logId, WARN, "Initiating factory reset...\n");
                 brain->factoryReset();
                 brain->reboot();
 
@@ -187,15 +186,15 @@ namespace droid::brain {
                 //This has 3 parms, so have to reparse parm2
                 split(parm2, parm2a, sizeof(parm2a), parm3, sizeof(parm3));
                 if (strlen(parm1) > 15) {
-                    logger->log(name, WARN, "Invalid config-name (%s) is longer than 15 characters\n", parm1);
+                    logger->log(logId, WARN, "Invalid config-name (%s) is longer than 15 characters\n", parm1);
                 } else if (strlen(parm1) == 0) {
-                    logger->log(name, WARN, "Invalid config-name must be specified\n");
+                    logger->log(logId, WARN, "Invalid config-name must be specified\n");
                 } else if (strlen(parm2a) > 15) {
-                    logger->log(name, WARN, "Invalid config-key (%s) is longer than 15 characters\n", parm2a);
+                    logger->log(logId, WARN, "Invalid config-key (%s) is longer than 15 characters\n", parm2a);
                 } else if (strlen(parm2a) == 0) {
-                    logger->log(name, WARN, "Invalid config-key must be specified\n");
+                    logger->log(logId, WARN, "Invalid config-key must be specified\n");
                 } else {
-                    logger->log(name, DEBUG, "SetConfig Name: '%s', Key: '%s', Value: '%s'\n",parm1, parm2a, parm3);
+                    LOGGER_LOG(logger, logId, DEBUG, "SetConfig Name: '%s', Key: '%s', Value: '%s'\n",parm1, parm2a, parm3);
                     config->putString((const char*) &parm1, (const char*) &parm2a, (const char*) &parm3);
                 }
 
@@ -208,13 +207,21 @@ namespace droid::brain {
             } else if (strcasecmp(cmd, "LogLevel") == 0) {
                 logger->setLogLevel(parm1, (LogLevel) atoi(parm2));
 
+            } else if (strcasecmp(cmd, "Stats") == 0) {
+                //Dump (or reset) the per-component task timing statistics
+                if (strcasecmp(parm1, "Reset") == 0) {
+                    brain->resetStats();
+                } else {
+                    brain->printStats(console);
+                }
+
             } else if ((strcasecmp(cmd, "Help") == 0) ||
                        (strcasecmp(cmd, "?") == 0)) {
                 //Provide help on using Local Commands
                 printHelp();
 
             } else {
-                logger->log(name, WARN, "LocalCmdHandler asked to process an undefined command: %s\n", command);
+                logger->log(logId, WARN, "LocalCmdHandler asked to process an undefined command: %s\n", command);
             }
             return true;
         } else {
@@ -253,6 +260,8 @@ namespace droid::brain {
             printCmdHelp("LogLevel <component> <level>", "Set the logger for the component to the level specified");
             printParmHelp("component", "The name of the component to set level for");
             printParmHelp("level", "The new log level: 0=DEBUG, 1=INFO, 2=WARN, 3=ERROR or 4=FATAL");
+            printCmdHelp("Stats [Reset]", "Print the schedule and task timing statistics (count, mean, p50, p99, max in microseconds, deadline misses and skipped periods) for each component");
+            printParmHelp("Reset", "Clear the statistics instead of printing them");
             console->print("\n");
         }
     }
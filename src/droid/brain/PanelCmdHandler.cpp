@@ -15,19 +15,23 @@
 #define CONFIG_KEY_PANEL_CLOSE_MICROSECONDS       "Panel%dClose"
 #define CONFIG_KEY_PANEL_TIME_MILLISECONDS        "Panel%dTime"
 #define CONFIG_KEY_PANEL_PWMOUT                   "Panel%dPWMOut"
+#define CONFIG_KEY_PANEL_EASE                     "Panel%dEase"
+#define CONFIG_KEY_PANEL_MOVE_MILLISECONDS        "Panel%dMove"
 #define CONFIG_DEFAULT_PANEL_OPEN_MICROSECONDS    1800
 #define CONFIG_DEFAULT_PANEL_CLOSE_MICROSECONDS   800
 #define CONFIG_DEFAULT_PANEL_TIME_MILLISECONDS    1000
+#define CONFIG_DEFAULT_PANEL_EASE                 droid::services::ServoEasing::CUBIC
+#define CONFIG_DEFAULT_PANEL_MOVE_MILLISECONDS    500
 
 namespace droid::brain {
     PanelCmdHandler::PanelCmdHandler(const char* name, droid::core::System* system) :
-        CmdHandler(name, system) {}
+        CmdHandler(name, system) {
+        setSchedule(SCHEDULE_PANEL_PERIOD_US, 0, SCHEDULE_PRIORITY_NORMAL);
+    }
 
-    bool PanelCmdHandler::process(const char* device, const char* command) {
+    bool PanelCmdHandler::execute(const char* command) {
         droid::services::PWMService* pwmService = system->getPWMService();
-        if ((strcmp(name, device)!= 0) ||
-            (command == NULL) ||
-            (pwmService == NULL)) {
+        if (pwmService == NULL) {
             return false;
         }
         //Parse the command
@@ -46,9 +50,7 @@ namespace droid::brain {
                 endIndex = panel - 1;
             }
             for (uint8_t index = startIndex; index <= endIndex; index++) {
-                pwmService->setPWMuS(panelDetails[index].pwmOutput, 
-                                        panelDetails[index].openMicroSeconds, 
-                                        panelDetails[index].timeMilliSeconds);
+                moveTo(pwmService, index, panelDetails[index].openMicroSeconds);
                 panelDetails[index].isOpen = true;
             }
             return true;
@@ -67,9 +69,7 @@ namespace droid::brain {
                 endIndex = panel - 1;
             }
             for (uint8_t index = startIndex; index <= endIndex; index++) {
-                pwmService->setPWMuS(panelDetails[index].pwmOutput, 
-                                        panelDetails[index].closeMicroSeconds, 
-                                        panelDetails[index].timeMilliSeconds);
+                moveTo(pwmService, index, panelDetails[index].closeMicroSeconds);
                 panelDetails[index].isOpen = false;
             }
             return true;
@@ -82,13 +82,16 @@ namespace droid::brain {
             buf[2] = command[5];
             buf[3] = '\0';
             uint8_t panel = atoi(buf);
-            if (panel > LOCAL_PANEL_COUNT) {return false;}
+            if ((panel == 0) || (panel > LOCAL_PANEL_COUNT)) {return false;}
             buf[0] = command[6];
             buf[1] = command[7];
             buf[2] = command[8];
             buf[3] = command[9];
             buf[4] = '\0';
             uint16_t pos = atoi(buf);
+            //Test positions are not eased
+            cancelMove(panel - 1);
+            panelDetails[panel - 1].currentMicroSeconds = pos;
             pwmService->setPWMuS(panelDetails[panel - 1].pwmOutput, pos, 100);
             return true;
         }
@@ -100,16 +103,28 @@ namespace droid::brain {
         char keyClose[16];
         char keyTime[16];
         char keyPWM[16];
+        char keyEase[16];
+        char keyMove[16];
         for (int i = 0; i < LOCAL_PANEL_COUNT; i++) {
             snprintf(keyOpen, sizeof(keyOpen), CONFIG_KEY_PANEL_OPEN_MICROSECONDS, i+1);
             snprintf(keyClose, sizeof(keyClose), CONFIG_KEY_PANEL_CLOSE_MICROSECONDS, i+1);
             snprintf(keyTime, sizeof(keyTime), CONFIG_KEY_PANEL_TIME_MILLISECONDS, i+1);
             snprintf(keyPWM, sizeof(keyPWM), CONFIG_KEY_PANEL_PWMOUT, i+1);
+            snprintf(keyEase, sizeof(keyEase), CONFIG_KEY_PANEL_EASE, i+1);
+            snprintf(keyMove, sizeof(keyMove), CONFIG_KEY_PANEL_MOVE_MILLISECONDS, i+1);
             panelDetails[i].openMicroSeconds = config->getInt(name, keyOpen, CONFIG_DEFAULT_PANEL_OPEN_MICROSECONDS);
             panelDetails[i].closeMicroSeconds = config->getInt(name, keyClose, CONFIG_DEFAULT_PANEL_CLOSE_MICROSECONDS);
             panelDetails[i].timeMilliSeconds = config->getInt(name, keyTime, CONFIG_DEFAULT_PANEL_TIME_MILLISECONDS);
             panelDetails[i].pwmOutput = config->getInt(name, keyPWM, PWMSERVICE_PANEL_FIRST_OUT + i);
+            int ease = config->getInt(name, keyEase, CONFIG_DEFAULT_PANEL_EASE);
+            if ((ease < droid::services::ServoEasing::NONE) || (ease > droid::services::ServoEasing::BOUNCE)) {
+                ease = CONFIG_DEFAULT_PANEL_EASE;
+            }
+            panelDetails[i].ease = (droid::services::ServoEasing::Curve) ease;
+            panelDetails[i].moveMilliSeconds = config->getInt(name, keyMove, CONFIG_DEFAULT_PANEL_MOVE_MILLISECONDS);
             panelDetails[i].isOpen = false;
+            panelDetails[i].moveState = MOVE_IDLE;
+            panelDetails[i].currentMicroSeconds = 0;
         }
     }
 
@@ -119,21 +134,93 @@ namespace droid::brain {
         char keyClose[16];
         char keyTime[16];
         char keyPWM[16];
+        char keyEase[16];
+        char keyMove[16];
         for (int i = 0; i < LOCAL_PANEL_COUNT; i++) {
             snprintf(keyOpen, sizeof(keyOpen), CONFIG_KEY_PANEL_OPEN_MICROSECONDS, i+1);
             snprintf(keyClose, sizeof(keyClose), CONFIG_KEY_PANEL_CLOSE_MICROSECONDS, i+1);
             snprintf(keyTime, sizeof(keyTime), CONFIG_KEY_PANEL_TIME_MILLISECONDS, i+1);
             snprintf(keyPWM, sizeof(keyPWM), CONFIG_KEY_PANEL_PWMOUT, i+1);
+            snprintf(keyEase, sizeof(keyEase), CONFIG_KEY_PANEL_EASE, i+1);
+            snprintf(keyMove, sizeof(keyMove), CONFIG_KEY_PANEL_MOVE_MILLISECONDS, i+1);
             config->putInt(name, keyOpen, CONFIG_DEFAULT_PANEL_OPEN_MICROSECONDS);
             config->putInt(name, keyClose, CONFIG_DEFAULT_PANEL_CLOSE_MICROSECONDS);
             config->putInt(name, keyTime, CONFIG_DEFAULT_PANEL_TIME_MILLISECONDS);
             config->putInt(name, keyPWM, PWMSERVICE_PANEL_FIRST_OUT + i);
+            config->putInt(name, keyEase, CONFIG_DEFAULT_PANEL_EASE);
+            config->putInt(name, keyMove, CONFIG_DEFAULT_PANEL_MOVE_MILLISECONDS);
         }
     }
 
+    //Steps every moving panel along its easing curve, the PWMService sends the steps together.
+    //  Waiting panels start as soon as fewer than PANEL_MAX_ACCELERATING panels are in the
+    //  first half of their move, so a group move does not draw every servo's start current at once.
     void PanelCmdHandler::task() {
-        //TODO probably noop?  If so, remove from .h and here
-        //Maybe flutter?
+        if (movingCount == 0) {
+            return;
+        }
+        droid::services::PWMService* pwmService = system->getPWMService();
+        if (pwmService == NULL) {
+            return;
+        }
+        uint32_t now = clock->millis();
+        uint8_t accelerating = 0;
+        for (uint8_t index = 0; index < LOCAL_PANEL_COUNT; index++) {
+            if ((panelDetails[index].moveState == MOVE_RUNNING) &&
+                ((now - panelDetails[index].moveStartMs) < (panelDetails[index].moveMilliSeconds / 2u))) {
+                accelerating++;
+            }
+        }
+        for (uint8_t index = 0; index < LOCAL_PANEL_COUNT; index++) {
+            if ((panelDetails[index].moveState == MOVE_WAITING) && (accelerating < PANEL_MAX_ACCELERATING)) {
+                panelDetails[index].moveState = MOVE_RUNNING;
+                panelDetails[index].moveStartMs = now;
+                accelerating++;
+            }
+            if (panelDetails[index].moveState != MOVE_RUNNING) {
+                continue;
+            }
+            uint32_t elapsed = now - panelDetails[index].moveStartMs;
+            panelDetails[index].currentMicroSeconds = droid::services::ServoEasing::interpolate(panelDetails[index].ease,
+                                                            panelDetails[index].fromMicroSeconds,
+                                                            panelDetails[index].targetMicroSeconds,
+                                                            elapsed,
+                                                            panelDetails[index].moveMilliSeconds);
+            //Each step restarts the output timeout, the servo is held for timeMilliSeconds after the move
+            pwmService->setPWMuS(panelDetails[index].pwmOutput,
+                                    panelDetails[index].currentMicroSeconds,
+                                    panelDetails[index].timeMilliSeconds);
+            if (elapsed >= panelDetails[index].moveMilliSeconds) {
+                panelDetails[index].moveState = MOVE_IDLE;
+                movingCount--;
+            }
+        }
+    }
+
+    //Queues an eased move to targetMicroSeconds, the move itself is made by task().  Panels
+    //  whose position is not known yet (first move after boot) jump as before.
+    void PanelCmdHandler::moveTo(droid::services::PWMService* pwmService, uint8_t index, uint16_t targetMicroSeconds) {
+        cancelMove(index);
+        if ((panelDetails[index].ease == droid::services::ServoEasing::NONE) ||
+            (panelDetails[index].moveMilliSeconds == 0) ||
+            (panelDetails[index].currentMicroSeconds == 0)) {
+            panelDetails[index].currentMicroSeconds = targetMicroSeconds;
+            pwmService->setPWMuS(panelDetails[index].pwmOutput, targetMicroSeconds, panelDetails[index].timeMilliSeconds);
+            return;
+        }
+        //A panel already moving turns around from where it is now, and waits for its turn again
+        panelDetails[index].fromMicroSeconds = panelDetails[index].currentMicroSeconds;
+        panelDetails[index].targetMicroSeconds = targetMicroSeconds;
+        panelDetails[index].moveState = MOVE_WAITING;
+        movingCount++;
+    }
+
+    //Drops a waiting or running move, keeping movingCount in step with the panel states
+    void PanelCmdHandler::cancelMove(uint8_t index) {
+        if (panelDetails[index].moveState != MOVE_IDLE) {
+            panelDetails[index].moveState = MOVE_IDLE;
+            movingCount--;
+        }
     }
 
     void PanelCmdHandler::logConfig() {
@@ -141,15 +228,21 @@ namespace droid::brain {
         char keyClose[16];
         char keyTime[16];
         char keyPWM[16];
+        char keyEase[16];
+        char keyMove[16];
         for (int i = 0; i < LOCAL_PANEL_COUNT; i++) {
             snprintf(keyOpen, sizeof(keyOpen), CONFIG_KEY_PANEL_OPEN_MICROSECONDS, i+1);
             snprintf(keyClose, sizeof(keyClose), CONFIG_KEY_PANEL_CLOSE_MICROSECONDS, i+1);
             snprintf(keyTime, sizeof(keyTime), CONFIG_KEY_PANEL_TIME_MILLISECONDS, i+1);
             snprintf(keyPWM, sizeof(keyPWM), CONFIG_KEY_PANEL_PWMOUT, i+1);
-            logger->log(name, INFO, "Config %s = %s\n", keyOpen, config->getString(name, keyOpen, "").c_str());
-            logger->log(name, INFO, "Config %s = %s\n", keyClose, config->getString(name, keyClose, "").c_str());
-            logger->log(name, INFO, "Config %s = %s\n", keyTime, config->getString(name, keyTime, "").c_str());
-            logger->log(name, INFO, "Config %s = %s\n", keyPWM, config->getString(name, keyPWM, "").c_str());
+            snprintf(keyEase, sizeof(keyEase), CONFIG_KEY_PANEL_EASE, i+1);
+            snprintf(keyMove, sizeof(keyMove), CONFIG_KEY_PANEL_MOVE_MILLISECONDS, i+1);
+            LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", keyOpen, config->getString(name, keyOpen, "").c_str());
+            LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", keyClose, config->getString(name, keyClose, "").c_str());
+            LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", keyTime, config->getString(name, keyTime, "").c_str());
+            LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", keyPWM, config->getString(name, keyPWM, "").c_str());
+            LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", keyEase, config->getString(name, keyEase, "").c_str());
+            LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", keyMove, config->getString(name, keyMove, "").c_str());
         }
     }
 
@@ -157,6 +250,7 @@ namespace droid::brain {
         droid::services::PWMService* pwmService = system->getPWMService();
         if (pwmService) {
             for (int i = 0; i < LOCAL_PANEL_COUNT; i++) {
+                cancelMove(i);
                 pwmService->setPWMpercent(panelDetails[i].pwmOutput, 0);
             }
         }
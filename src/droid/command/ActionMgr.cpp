@@ -8,12 +8,16 @@
  * For more information, visit https://github.com/kizmit99/MechMind
  */
 
+#define LOGGER_FLOOR LOGGER_FLOOR_ACTIONMGR
 #include "droid/command/ActionMgr.h"
 
 namespace droid::command {
     ActionMgr::ActionMgr(const char* name, droid::core::System* system, droid::controller::Controller* controller) :
         BaseComponent(name, system),
-        controller(controller) {}
+        controller(controller),
+        actionNames(system->getActionNames()) {
+        setSchedule(SCHEDULE_NORMAL_PERIOD_US, SCHEDULE_NORMAL_PERIOD_US / 4, SCHEDULE_PRIORITY_NORMAL);
+    }
 
     void ActionMgr::init() {
         //init cmdMap with defaults then load overrides from config
@@ -28,11 +32,20 @@ namespace droid::command {
                 cmdMap[action] = override;
             }
         }
+        compilePrograms();
     }
 
     void ActionMgr::addCmdHandler(droid::command::CmdHandler* cmdHandler) {
         if (cmdHandler) {
-            cmdHandlers.push_back(cmdHandler);
+            if (cmdHandler->isMonitor()) {
+                cmdMonitors.push_back(cmdHandler);
+            } else {
+                cmdHandlers.push_back(cmdHandler);
+                //Resolve any programs compiled before this handler was added
+                if (!programs.empty()) {
+                    compilePrograms();
+                }
+            }
         }
     }
 
@@ -67,6 +80,7 @@ namespace droid::command {
                 cmdMap[action] = cmd;
                 config->putString(name, action, cmd);
             }
+            compileProgram(actionNames->intern(action));
         }
     }
 
@@ -74,102 +88,140 @@ namespace droid::command {
         // Iterate through the cmdMap for keys to log
         for (const auto& mapEntry : cmdMap) {
             const char* action = mapEntry.first.c_str();
-            logger->log(name, INFO, "Config %s = %s\n", action, config->getString(name, action, "").c_str());
+            LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", action, config->getString(name, action, "").c_str());
         }
     }
 
     void ActionMgr::fireAction(const char* action) {
-        if (cmdMap.count(action) > 0) {
-            parseCommands(cmdMap[action].c_str());
+        uint16_t actionId = actionNames->find(action);
+        if (actionId != NAMETABLE_NONE) {
+            fireAction(actionId);
         } else {
-            logger->log(name, DEBUG, "Action (%s) not recognized, trying to parse as a command\n", action);
-            parseCommands(action);
+            LOGGER_LOG(logger, logId, DEBUG, "Action (%s) not recognized, trying to parse as a command\n", action);
+            adhocProgram.compile("", action, cmdHandlers);
+            queueProgram(adhocProgram);
+        }
+    }
+
+    void ActionMgr::fireAction(uint16_t actionId) {
+        if (actionId == NAMETABLE_NONE) {
+            return;
         }
+        if ((actionId >= programs.size()) || !programs[actionId].isCompiled()) {
+            //Interned after init(), typically a Controller trigger mapped straight to a command
+            compileProgram(actionId);
+        }
+        queueProgram(programs[actionId]);
     }
 
     void ActionMgr::task() {
-        String action = controller->getAction();
-        unsigned long now = millis();
-        if ((action == lastAction) &&
-            (now < (lastActionTime + 1000))) {
-            //Skip it
-        } else {
-            lastActionTime = now;
-            lastAction = action;
-            if (action != "") {
-                logger->log(name, DEBUG, "Trigger: %s, Cmd: %s\n", action.c_str(), cmdMap[action].c_str());
-                fireAction(action.c_str());
+        droid::controller::InputSnapshot input = controller->getInput();
+        uint16_t action = NAMETABLE_NONE;
+        if (input.actionSeq != lastActionSeq) {
+            //The Controller reported an Action since the last task()
+            lastActionSeq = input.actionSeq;
+            action = input.action;
+        }
+        unsigned long now = clock->millis();
+        if (action != NAMETABLE_NONE) {
+            if ((action == lastAction) &&
+                (now < (lastActionTime + 1000))) {
+                //Skip it, the trigger is still held
+            } else {
+                lastActionTime = now;
+                lastAction = action;
+                LOGGER_LOG(logger, logId, DEBUG, "Action: %s\n", actionNames->getName(action));
+                fireAction(action);
             }
+        } else if (input.heldAction == NAMETABLE_NONE) {
+            //Released, so its next press fires right away.  A run without a new sample
+            //  (the control task is not in step with this one) leaves lastAction alone.
+            lastAction = NAMETABLE_NONE;
         }
         executeCommands();
     }
 
-    // Parse the command sequence and store commands with their execute times
-    void ActionMgr::parseCommands(const char* sequence) {
-        char buf[ACTION_MAX_SEQUENCE_LEN];
-        strncpy(buf, sequence, sizeof(buf));  // Create a copy of the sequence to avoid modifying the original
-        char* token = strtok(buf, ";");
-        char currentDevice[INSTRUCTIONLIST_DEVICE_LEN] = "";
-        unsigned long currentTime = millis();
-        unsigned long cumulativeDelay = 0;
-
-        while (token != NULL) {
-            char* greaterPos = strchr(token, '>');
-            if (greaterPos != NULL) {
-                // It's a device token
-                *greaterPos = '\0';  // Null-terminate the device name
-                strncpy(currentDevice, token, sizeof(currentDevice));
-                token = greaterPos + 1;
-                continue;
-            }
-            if (token[0] == '#') {
-                // It's a delay
-                unsigned long delay = strtoul(token + 1, NULL, 10);
-                cumulativeDelay += delay;
-            } else {
-                // It's a simple or panel instruction
-                queueCommand(currentDevice, token, currentTime + cumulativeDelay);
-                logger->log(name, DEBUG, "parsed device: %s, cmd: %s\n",currentDevice, token);
+    void ActionMgr::compileProgram(uint16_t actionId) {
+        if (actionId == NAMETABLE_NONE) {
+            return;
+        }
+        if (actionId >= programs.size()) {
+            programs.resize(actionNames->size());
+        }
+        const char* action = actionNames->getName(actionId);
+        auto mapEntry = cmdMap.find(action);
+        if (mapEntry != cmdMap.end()) {
+            programs[actionId].compile(action, mapEntry->second.c_str(), cmdHandlers);
+        } else {
+            //Not a named Action, the name itself is the command sequence
+            LOGGER_LOG(logger, logId, DEBUG, "Action (%s) not recognized, trying to parse as a command\n", action);
+            programs[actionId].compile(action, action, cmdHandlers);
+        }
+    }
+
+    void ActionMgr::compilePrograms() {
+        for (const auto& mapEntry : cmdMap) {
+            actionNames->intern(mapEntry.first.c_str());
+        }
+        programs.clear();
+        programs.resize(actionNames->size());
+        //Also covers Actions interned by the Controllers' trigger maps
+        for (uint16_t actionId = 1; actionId < actionNames->size(); actionId++) {
+            compileProgram(actionId);
+        }
+    }
+
+    // Store the program's commands with their execute times
+    void ActionMgr::queueProgram(const ActionProgram& program) {
+        unsigned long currentTime = clock->millis();
+        for (size_t index = 0; index < program.size(); index++) {
+            const ActionStep& step = program.getStep(index);
+            const char* device = program.getText(step.device);
+            const char* command = program.getText(step.command);
+            droid::core::Instruction* newInstruction = instructionList.addInstruction(currentTime + step.delayMs);
+            if (newInstruction == NULL) {
+                logger->log(logId, WARN, "Command Queue is FULL, dropping command: %s\n", command);
+                instructionList.dump(name, logger, WARN);
+                return;
             }
-            token = strtok(NULL, ";");
+            //The program text is already truncated to fit
+            strcpy(newInstruction->device, device);
+            strcpy(newInstruction->command, command);
+            newInstruction->target = step.handler;
+            LOGGER_LOG(logger, logId, DEBUG, "queued device: %s, cmd: %s\n", device, command);
         }
     }
 
     void ActionMgr::queueCommand(const char* device, const char* command, unsigned long executeTime) {
-        droid::core::Instruction* newInstruction = instructionList.addInstruction();
+        droid::core::Instruction* newInstruction = instructionList.addInstruction(executeTime);
         if (newInstruction == NULL) {
-            logger->log(name, WARN, "Command Queue is FULL, dropping command: %s\n", command);
+            logger->log(logId, WARN, "Command Queue is FULL, dropping command: %s\n", command);
             instructionList.dump(name, logger, WARN);
             return;
         }
         strncpy(newInstruction->device, device, INSTRUCTIONLIST_DEVICE_LEN);
+        newInstruction->device[INSTRUCTIONLIST_DEVICE_LEN - 1] = 0;
         strncpy(newInstruction->command, command, INSTRUCTIONLIST_COMMAND_LEN);
-        newInstruction->executeTime = executeTime;
+        newInstruction->command[INSTRUCTIONLIST_COMMAND_LEN - 1] = 0;
+        newInstruction->target = ActionProgram::findHandler(newInstruction->device, cmdHandlers);
     }
 
     // Execute commands at the proper times
     void ActionMgr::executeCommands() {
-        unsigned long currentTime = millis();
-        droid::core::Instruction* instruction = instructionList.initLoop();
-        while (instruction != NULL) {
-            if (currentTime >= instruction->executeTime) {
-
-                logger->log(name, DEBUG, "Sending command to %s: %s at time: %d\n", instruction->device, instruction->command, currentTime);
-
-                bool consumed = false;
-                for (droid::command::CmdHandler* cmdHandler : cmdHandlers) {
-                    consumed |= cmdHandler->process(instruction->device, instruction->command);
-                    if (consumed) {
-                        break;
-                    }
-                }
-                if (!consumed) {
-                    logger->log(name, WARN, "Command was not handled.  Device: %s, cmd: %s\n", instruction->device, instruction->command);
-                }
+        unsigned long currentTime = clock->millis();
+        droid::core::Instruction instruction;
+        while (instructionList.popDue(currentTime, instruction)) {
+            LOGGER_LOG(logger, logId, DEBUG, "Sending command to %s: %s at time: %lu\n", instruction.device, instruction.command, currentTime);
 
-                instruction = instructionList.deleteInstruction(instruction);
-            } else {
-                instruction = instruction->next;
+            for (droid::command::CmdHandler* cmdMonitor : cmdMonitors) {
+                cmdMonitor->process(instruction.device, instruction.command);
+            }
+            bool consumed = false;
+            if (instruction.target < cmdHandlers.size()) {
+                consumed = cmdHandlers[instruction.target]->execute(instruction.command);
+            }
+            if (!consumed) {
+                logger->log(logId, WARN, "Command was not handled.  Device: %s, cmd: %s\n", instruction.device, instruction.command);
             }
         }
     }
@@ -0,0 +1,88 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use.
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include "droid/command/ActionProgram.h"
+
+namespace droid::command {
+
+    void ActionProgram::compile(const char* name, const char* sequence, const std::vector<CmdHandler*>& cmdHandlers) {
+        steps.clear();
+        text.clear();
+        intern(name, strlen(name));
+        if (sequence == NULL) {
+            return;
+        }
+
+        uint16_t currentDevice = intern("", 0);
+        uint8_t currentHandler = INSTRUCTIONLIST_NO_TARGET;
+        unsigned long cumulativeDelay = 0;
+        const char* token = sequence;
+        while (*token != 0) {
+            const char* end = strchr(token, ';');
+            if (end == NULL) {
+                end = token + strlen(token);
+            }
+            if (end == token) {     //Skip empty tokens, as strtok would
+                token++;
+                continue;
+            }
+
+            const char* greaterPos = (const char*) memchr(token, '>', end - token);
+            while (greaterPos != NULL) {
+                // It's a device token
+                size_t len = min((size_t) (greaterPos - token), (size_t) (INSTRUCTIONLIST_DEVICE_LEN - 1));
+                currentDevice = internDevice(token, len);
+                currentHandler = findHandler(getText(currentDevice), cmdHandlers);
+                token = greaterPos + 1;
+                greaterPos = (const char*) memchr(token, '>', end - token);
+            }
+
+            if (token[0] == '#') {
+                // It's a delay
+                cumulativeDelay += strtoul(token + 1, NULL, 10);
+            } else {
+                // It's a simple or panel instruction
+                ActionStep step;
+                step.delayMs = cumulativeDelay;
+                step.device = currentDevice;
+                step.command = intern(token, min((size_t) (end - token), (size_t) (INSTRUCTIONLIST_COMMAND_LEN - 1)));
+                step.handler = currentHandler;
+                steps.push_back(step);
+            }
+            token = (*end == ';') ? end + 1 : end;
+        }
+    }
+
+    uint8_t ActionProgram::findHandler(const char* device, const std::vector<CmdHandler*>& cmdHandlers) {
+        for (size_t index = 0; (index < cmdHandlers.size()) && (index < INSTRUCTIONLIST_NO_TARGET); index++) {
+            if (cmdHandlers[index]->handlesDevice(device)) {
+                return index;
+            }
+        }
+        return INSTRUCTIONLIST_NO_TARGET;
+    }
+
+    uint16_t ActionProgram::intern(const char* str, size_t len) {
+        uint16_t offset = text.size();
+        text.insert(text.end(), str, str + len);
+        text.push_back(0);
+        return offset;
+    }
+
+    uint16_t ActionProgram::internDevice(const char* device, size_t len) {
+        for (const ActionStep& step : steps) {
+            const char* existing = getText(step.device);
+            if ((strncmp(existing, device, len) == 0) && (existing[len] == 0)) {
+                return step.device;
+            }
+        }
+        return intern(device, len);
+    }
+}
@@ -15,7 +15,15 @@ namespace droid::command {
         CmdHandler(name, system) {}
 
     bool CmdLogger::process(const char* device, const char* command) {
-        logger->log(name, INFO, "Device: %s, Command: %s\n", device, command);
+        LOGGER_LOG(logger, logId, INFO, "Device: %s, Command: %s\n", device, command);
         return false;
     }
+
+    bool CmdLogger::execute(const char* command) {
+        return false;
+    }
+
+    bool CmdLogger::isMonitor() {
+        return true;
+    }
 }
@@ -14,14 +14,9 @@ namespace droid::command {
     ESPNowCmdHandler::ESPNowCmdHandler(const char* name, droid::core::System* system) :
         CmdHandler(name, system) {}
 
-    bool ESPNowCmdHandler::process(const char* device, const char* command) {
-        if ((strcmp(name, device) == 0) &&
-            (command != NULL)) {
-            //TODO Implement
-            logger->log(name, WARN, "ESPNowCmdHandler not implemented!\n");
-            return true;
-        } else {
-            return false;
-        }
+    bool ESPNowCmdHandler::execute(const char* command) {
+        //TODO Implement
+        logger->log(logId, WARN, "ESPNowCmdHandler not implemented!\n");
+        return true;
     }
 }
\ No newline at end of file
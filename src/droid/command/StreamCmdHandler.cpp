@@ -15,15 +15,10 @@ namespace droid::command {
         CmdHandler(name, system),
         stream(stream) {}
 
-    bool StreamCmdHandler::process(const char* device, const char* command) {
-        if ((strcmp(name, device) == 0) &&
-            (command != NULL)) {
-            if (stream != NULL) {
-                stream->printf("%s\r", command);
-            }
-            return true;
-        } else {
-            return false;
+    bool StreamCmdHandler::execute(const char* command) {
+        if (stream != NULL) {
+            stream->printf("%s\r", command);
         }
+        return true;
     }
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include "droid/controller/Controller.h"
+
+namespace droid::controller {
+
+    void Controller::sample() {
+        InputSnapshot next = input;
+        next.buttons = readButtons();
+        for (uint8_t joystick = 0; joystick < 2; joystick++) {
+            for (uint8_t axis = 0; axis < 2; axis++) {
+                next.joystick[joystick][axis] = getJoystickPosition((Joystick) joystick, (Axis) axis);
+            }
+        }
+        uint16_t action = getAction(next.buttons);
+        next.heldAction = action;
+        if (action != NAMETABLE_NONE) {
+            next.action = action;
+            next.actionSeq++;
+        }
+        next.timestamp = clock->millis();
+        next.sequence++;
+        input = next;
+    }
+}
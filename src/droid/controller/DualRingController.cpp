@@ -27,11 +27,70 @@ constexpr blering::DualRingBLE::Button DualRingBLE_Right = blering::DualRingBLE:
 constexpr blering::DualRingBLE::Axis DualRingBLE_X = blering::DualRingBLE::Axis::X; 
 constexpr blering::DualRingBLE::Axis DualRingBLE_Y = blering::DualRingBLE::Axis::Y; 
 
+namespace {
+    //Bit number of each button in the mask returned by readButtons()
+    enum TriggerButton : uint8_t {
+        BTN_LC, BTN_LD, BTN_LL1, BTN_RC, BTN_RD, BTN_RL1,
+        BTN_LUP, BTN_LDOWN, BTN_LLEFT, BTN_LRIGHT,
+        BTN_RUP, BTN_RDOWN, BTN_RLEFT, BTN_RRIGHT,
+        BTN_LA, BTN_LB, BTN_LL2, BTN_RA, BTN_RB, BTN_RL2,
+        BTN_COUNT};
+
+    //Each group is read from the Dome ring then the Drive ring, in bit order
+    const blering::DualRingBLE::Controller ringOrder[] = {DualRingBLE_Dome, DualRingBLE_Drive};
+    const blering::DualRingBLE::Clicker clickButtons[] = {DualRingBLE_C, DualRingBLE_D, DualRingBLE_L1};
+    const blering::DualRingBLE::Button pressButtons[] = {DualRingBLE_Up, DualRingBLE_Down, DualRingBLE_Left, DualRingBLE_Right};
+    const blering::DualRingBLE::Modifier modifierButtons[] = {DualRingBLE_A, DualRingBLE_B, DualRingBLE_L2};
+
+    const char* const buttonNames[BTN_COUNT] = {
+        "LC", "LD", "LL1", "RC", "RD", "RL1",
+        "Lup", "Ldown", "Lleft", "Lright",
+        "Rup", "Rdown", "Rleft", "Rright",
+        "LA", "LB", "LL2", "RA", "RB", "RL2"};
+
+    const uint32_t CLICKS = bit(BTN_LC) | bit(BTN_LD) | bit(BTN_LL1) | bit(BTN_RC) | bit(BTN_RD) | bit(BTN_RL1);
+    const uint32_t DOME_JOYSTICK = bit(BTN_LUP) | bit(BTN_LDOWN) | bit(BTN_LLEFT) | bit(BTN_LRIGHT);
+    const uint32_t DRIVE_JOYSTICK = bit(BTN_RUP) | bit(BTN_RDOWN) | bit(BTN_RLEFT) | bit(BTN_RRIGHT);
+    const uint32_t DOME_AB = bit(BTN_LA) | bit(BTN_LB);
+    const uint32_t DRIVE_AB = bit(BTN_RA) | bit(BTN_RB);
+
+    //Button definitions for Dual Ring Triggers to mimic PenumbraShadowMD, in priority order
+    const droid::controller::TriggerLayer triggerLayers[] = {
+        //Click triggers
+        {"", "", 0, 0, CLICKS},
+        //Dome Joystick + Drive-A/B
+        {"RA_", "", bit(BTN_RA), DOME_AB | bit(BTN_LL2), DOME_JOYSTICK},
+        {"RB_", "", bit(BTN_RB), DOME_AB | bit(BTN_LL2), DOME_JOYSTICK},
+        //Dome Joystick + Dome-A/B (Requires two hands, not stealthy)
+        {"LA_", "", bit(BTN_LA), DRIVE_AB | bit(BTN_LL2), DOME_JOYSTICK},
+        {"LB_", "", bit(BTN_LB), DRIVE_AB | bit(BTN_LL2), DOME_JOYSTICK},
+        //Drive Joystick + Dome-A/B
+        {"LA_", "", bit(BTN_LA), DRIVE_AB | bit(BTN_RL2), DRIVE_JOYSTICK},
+        {"LB_", "", bit(BTN_LB), DRIVE_AB | bit(BTN_RL2), DRIVE_JOYSTICK},
+        //Drive Joystick + Drive-A/B (Requires two hands, not stealthy)
+        {"RA_", "", bit(BTN_RA), DOME_AB | bit(BTN_RL2), DRIVE_JOYSTICK},
+        {"RB_", "", bit(BTN_RB), DOME_AB | bit(BTN_RL2), DRIVE_JOYSTICK},
+        //Dome Joystick + Dome-A/B + Drive-A/B (Requries two hands, awkward to use)
+        {"LA_RA_", "", bit(BTN_LA) | bit(BTN_RA), bit(BTN_LL2), DOME_JOYSTICK},
+        {"LA_RB_", "", bit(BTN_LA) | bit(BTN_RB), bit(BTN_LL2), DOME_JOYSTICK},
+        {"LB_RA_", "", bit(BTN_LB) | bit(BTN_RA), bit(BTN_LL2), DOME_JOYSTICK},
+        {"LB_RB_", "", bit(BTN_LB) | bit(BTN_RB), bit(BTN_LL2), DOME_JOYSTICK},
+        //Drive Joystick + Drive-A/B + Dome-A/B (Requries two hands, awkward to use)
+        {"RA_LA_", "", bit(BTN_LA) | bit(BTN_RA) | bit(BTN_RL2), 0, DRIVE_JOYSTICK},
+        {"RA_LB_", "", bit(BTN_LB) | bit(BTN_RA) | bit(BTN_RL2), 0, DRIVE_JOYSTICK},
+        {"RB_LA_", "", bit(BTN_LA) | bit(BTN_RB) | bit(BTN_RL2), 0, DRIVE_JOYSTICK},
+        {"RB_LB_", "", bit(BTN_LB) | bit(BTN_RB) | bit(BTN_RL2), 0, DRIVE_JOYSTICK},
+        //Dome Joystick + no modifiers (Avoid, easily triggered accidentally)
+        {"", "", 0, DOME_AB | DRIVE_AB | bit(BTN_RL2), DOME_JOYSTICK},
+        //Drive Joystick + no modifiers (Avoid, easily triggered accidentally)
+        {"", "", 0, DOME_AB | DRIVE_AB | bit(BTN_LL2), DRIVE_JOYSTICK}};
+}
+
 namespace droid::controller {
     DualRingController::DualRingController(const char* name, droid::core::System* system) :
         Controller(name, system) {
         if (DualRingController::instance != NULL) {
-            logger->log(name, ERROR, "\nFATAL Problem - constructor for DualRingController called more than once!\r\n");
+            logger->log(logId, ERROR, "\nFATAL Problem - constructor for DualRingController called more than once!\r\n");
             while (1);
         }
         DualRingController::instance = this;
@@ -50,6 +109,8 @@ namespace droid::controller {
                 triggerMap[trigger] = override;
             }
         }
+        triggerTable.build(triggerMap, system->getActionNames(), buttonNames, BTN_COUNT,
+                           triggerLayers, sizeof(triggerLayers) / sizeof(triggerLayers[0]));
 
         rings.init("DualRingBLE", logger, config);
     }
@@ -72,7 +133,7 @@ namespace droid::controller {
         // Iterate through the triggerMap for keys to log
         for (const auto& mapEntry : triggerMap) {
             const char* trigger = mapEntry.first.c_str();
-            logger->log(name, INFO, "Config %s = %s\n", trigger, config->getString(name, trigger, "").c_str());
+            LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", trigger, config->getString(name, trigger, "").c_str());
         }
 
         rings.logConfig();
@@ -81,6 +142,7 @@ namespace droid::controller {
     void DualRingController::task() {
         rings.task();
         faultCheck();
+        sample();
     }
 
     void DualRingController::failsafe() {
@@ -95,7 +157,7 @@ namespace droid::controller {
         if ((!faultState) &&
             (!rings.isConnected())) {
             faultState = true;
-            logger->log(name, ERROR, "Controller has lost connection to one of the Rings\n");
+            LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "Controller has lost connection to one of the Rings\n");
         }
         if ((faultState) &&
             (rings.isConnected())) {
@@ -126,219 +188,32 @@ namespace droid::controller {
         return normalizedValue;
     }
 
-    String DualRingController::getAction() {
-        //Button definitions for Dual Ring Triggers to mimic PenumbraShadowMD
-        String trigger = getTrigger();
-        if (trigger == "") {    //No trigger detected
-            return "";
-        }
-        return triggerMap[trigger];
+    uint16_t DualRingController::getAction(uint32_t buttons) {
+        return triggerTable.getAction(buttons);
     }
 
-    String DualRingController::getTrigger() {
-        //Click triggers
-        if (rings.isButtonClicked(DualRingBLE_Dome, DualRingBLE_C)) return "LC";
-        if (rings.isButtonClicked(DualRingBLE_Dome, DualRingBLE_D)) return "LD";
-        if (rings.isButtonClicked(DualRingBLE_Dome, DualRingBLE_L1)) return "LL1";
-        if (rings.isButtonClicked(DualRingBLE_Drive, DualRingBLE_C)) return "RC";
-        if (rings.isButtonClicked(DualRingBLE_Drive, DualRingBLE_D)) return "RD";
-        if (rings.isButtonClicked(DualRingBLE_Drive, DualRingBLE_L1)) return "RL1";
-
-        // Dome Joystick + Drive-A
-        if (rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_L2)) {
-            if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Up)) return "RA_Lup";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Down)) return "RA_Ldown";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Left)) return "RA_Lleft";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Right)) return "RA_Lright";
-        }
-
-        //Dome Joystick + Drive-B
-        if (rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_L2)) {
-            if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Up)) return "RB_Lup";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Down)) return "RB_Ldown";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Left)) return "RB_Lleft";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Right)) return "RB_Lright";
-        }
-
-        //Dome Joystick + Dome-A (Requires two hands, not stealthy)
-        if (!rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B) &&
-            rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_L2)) {
-            if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Up)) return "LA_Lup";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Down)) return "LA_Ldown";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Left)) return "LA_Lleft";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Right)) return "LA_Lright";
-        }
-
-        //Dome Joystick + Dome-B (Requires two hands, not stealthy)
-        if (!rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B) &&
-            rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_L2)) {
-            if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Up)) return "LB_Lup";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Down)) return "LB_Ldown";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Left)) return "LB_Lleft";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Right)) return "LB_Lright";
-        }
-
-        //Drive Joystick + Dome-A
-        if (!rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_L2) &&
-            rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A)) {
-            if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Up)) return "LA_Rup";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Down)) return "LA_Rdown";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Left)) return "LA_Rleft";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Right)) return "LA_Rright";
-        }
-
-        //Drive Joystick + Dome-B
-        if (!rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_L2) &&
-            rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B)) {
-            if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Up)) return "LB_Rup";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Down)) return "LB_Rdown";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Left)) return "LB_Rleft";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Right)) return "LB_Rright";
-        }
-
-        //Drive Joystick + Drive-A (Requires two hands, not stealthy)
-        if (rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_L2) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B)) {
-            if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Up)) return "RA_Rup";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Down)) return "RA_Rdown";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Left)) return "RA_Rleft";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Right)) return "RA_Rright";
-        }
-
-        //Drive Joystick + Drive-B (Requires two hands, not stealthy)
-        if (rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_L2) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B)) {
-            if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Up)) return "RB_Rup";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Down)) return "RB_Rdown";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Left)) return "RB_Rleft";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Right)) return "RB_Rright";
-        }
-
-        //Dome Joystick + Dome-A + Drive-A (Requries two hands, awkward to use)
-        if (rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_L2) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A)) {
-            if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Up)) return "LA_RA_Lup";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Down)) return "LA_RA_Ldown";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Left)) return "LA_RA_Lleft";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Right)) return "LA_RA_Lright";
-        }
-
-        //Dome Joystick + Dome-A + Drive-B (Requries two hands, awkward to use)
-        if (rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_L2) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B)) {
-            if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Up)) return "LA_RB_Lup";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Down)) return "LA_RB_Ldown";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Left)) return "LA_RB_Lleft";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Right)) return "LA_RB_Lright";
-        }
-
-        //Dome Joystick + Dome-B + Drive-A (Requries two hands, awkward to use)
-        if (rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_L2) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A)) {
-            if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Up)) return "LB_RA_Lup";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Down)) return "LB_RA_Ldown";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Left)) return "LB_RA_Lleft";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Right)) return "LB_RA_Lright";
-        }
-
-        //Dome Joystick + Dome-B + Drive-B (Requries two hands, awkward to use)
-        if (rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_L2) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B)) {
-            if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Up)) return "LB_RB_Lup";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Down)) return "LB_RB_Ldown";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Left)) return "LB_RB_Lleft";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Right)) return "LB_RB_Lright";
-        }
-
-
-        //Drive Joystick + Drive-A + Dome-A (Requries two hands, awkward to use)
-        if (rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_L2)) {
-            if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Up)) return "RA_LA_Rup";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Down)) return "RA_LA_Rdown";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Left)) return "RA_LA_Rleft";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Right)) return "RA_LA_Rright";
-        }
-
-        //Drive Joystick + Drive-A + Dome-B (Requries two hands, awkward to use)
-        if (rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_L2)) {
-            if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Up)) return "RA_LB_Rup";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Down)) return "RA_LB_Rdown";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Left)) return "RA_LB_Rleft";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Right)) return "RA_LB_Rright";
-        }
-
-        //Drive Joystick + Drive-B + Dome-A (Requries two hands, awkward to use)
-        if (rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_L2)) {
-            if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Up)) return "RB_LA_Rup";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Down)) return "RB_LA_Rdown";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Left)) return "RB_LA_Rleft";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Right)) return "RB_LA_Rright";
-        }
-
-        //Drive Joystick + Drive-B + Dome-B (Requries two hands, awkward to use)
-        if (rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B) &&
-            rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_L2)) {
-            if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Up)) return "RB_LB_Rup";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Down)) return "RB_LB_Rdown";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Left)) return "RB_LB_Rleft";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Right)) return "RB_LB_Rright";
+    uint32_t DualRingController::readButtons() {
+        uint32_t buttons = 0;
+        uint8_t button = 0;
+        for (blering::DualRingBLE::Controller ring : ringOrder) {
+            for (blering::DualRingBLE::Clicker clickButton : clickButtons) {
+                if (rings.isButtonClicked(ring, clickButton)) buttons |= bit(button);
+                button++;
+            }
         }
-
-
-        //Dome Joystick + no modifiers (Avoid, easily triggered accidentally)
-        if (!rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_L2)) {
-            if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Up)) return "Lup";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Down)) return "Ldown";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Left)) return "Lleft";
-            else if (rings.isButtonPressed(DualRingBLE_Dome, DualRingBLE_Right)) return "Lright";
+        for (blering::DualRingBLE::Controller ring : ringOrder) {
+            for (blering::DualRingBLE::Button pressButton : pressButtons) {
+                if (rings.isButtonPressed(ring, pressButton)) buttons |= bit(button);
+                button++;
+            }
         }
-
-        //Drive Joystick + no modifiers (Avoid, easily triggered accidentally)
-        if (!rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_B) &&
-            !rings.isModifierPressed(DualRingBLE_Dome, DualRingBLE_L2) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_A) &&
-            !rings.isModifierPressed(DualRingBLE_Drive, DualRingBLE_B)) {
-            if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Up)) return "Rup";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Down)) return "Rdown";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Left)) return "Rleft";
-            else if (rings.isButtonPressed(DualRingBLE_Drive, DualRingBLE_Right)) return "Rright";
+        for (blering::DualRingBLE::Controller ring : ringOrder) {
+            for (blering::DualRingBLE::Modifier modifierButton : modifierButtons) {
+                if (rings.isModifierPressed(ring, modifierButton)) buttons |= bit(button);
+                button++;
+            }
         }
-
-        return "";
+        return buttons;
     }
 }
 
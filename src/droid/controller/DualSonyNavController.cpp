@@ -28,6 +28,55 @@
 #define CONFIG_DEFAULT_SONY_BAD_DATA_WINDOW  50
 #define CONFIG_DEFAULT_SONY_DEADBAND         20
 
+namespace {
+    //Bit number of each button in the mask returned by readButtons(),
+    //the Left controller uses the same layout shifted up by LEFT_SHIFT
+    enum TriggerButton : uint8_t {
+        BTN_RUP, BTN_RDOWN, BTN_RLEFT, BTN_RRIGHT, BTN_RX, BTN_RO, BTN_RL1, BTN_RPS, BTN_RL2, BTN_RL3,
+        BTN_LUP, BTN_LDOWN, BTN_LLEFT, BTN_LRIGHT, BTN_LX, BTN_LO, BTN_LL1, BTN_LPS, BTN_LL2, BTN_LL3,
+        BTN_COUNT};
+    const uint8_t LEFT_SHIFT = BTN_LUP;
+
+    //Read with getButtonPress() on each controller, in bit order
+    const ButtonEnum pressButtons[] = {
+        ButtonEnum::UP, ButtonEnum::DOWN, ButtonEnum::LEFT, ButtonEnum::RIGHT,
+        ButtonEnum::CROSS, ButtonEnum::CIRCLE, ButtonEnum::L1, ButtonEnum::PS, ButtonEnum::L2, ButtonEnum::L3};
+
+    const char* const buttonNames[BTN_COUNT] = {
+        "Rup", "Rdown", "Rleft", "Rright", "RX", "RO", "RL1", "RPS", "RL2", "RL3",
+        "Lup", "Ldown", "Lleft", "Lright", "LX", "LO", "LL1", "LPS", "LL2", "LL3"};
+
+    //Modifiers that may be pressed on the 'other' controller (or on this one when it is alone)
+    const uint32_t SHARED_MODIFIERS = bit(BTN_RX) | bit(BTN_RO) | bit(BTN_RPS);
+    const uint32_t RIGHT_DPAD = bit(BTN_RUP) | bit(BTN_RDOWN) | bit(BTN_RLEFT) | bit(BTN_RRIGHT);
+    const uint32_t LEFT_DPAD = RIGHT_DPAD << LEFT_SHIFT;
+    const uint32_t NOT_RIGHT_BASE = bit(BTN_RX) | bit(BTN_RO) | bit(BTN_RL1) | bit(BTN_RPS) | (SHARED_MODIFIERS << LEFT_SHIFT);
+    const uint32_t NOT_LEFT_BASE = (bit(BTN_RX) | bit(BTN_RO) | bit(BTN_RL1) | bit(BTN_RPS)) << LEFT_SHIFT | SHARED_MODIFIERS;
+
+    //Button definitions for Dual Sony Triggers to mimic PenumbraShadowMD, in priority order
+    const droid::controller::TriggerLayer triggerLayers[] = {
+        // Base buttons on Right controller
+        {"", "", 0, NOT_RIGHT_BASE, RIGHT_DPAD},
+        // Modifier + base buttons on Right controller
+        {"LX_", "", bit(BTN_LX), 0, RIGHT_DPAD},
+        {"LO_", "", bit(BTN_LO), 0, RIGHT_DPAD},
+        {"RL1_", "", bit(BTN_RL1), 0, RIGHT_DPAD},
+        {"LPS_", "", bit(BTN_LPS), 0, RIGHT_DPAD},
+        // Base buttons on Left controller
+        {"", "", 0, NOT_LEFT_BASE, LEFT_DPAD},
+        // Modifier + base buttons on Left controller
+        {"RX_", "", bit(BTN_RX), 0, LEFT_DPAD},
+        {"RO_", "", bit(BTN_RO), 0, LEFT_DPAD},
+        {"LL1_", "", bit(BTN_LL1), 0, LEFT_DPAD},
+        {"RPS_", "", bit(BTN_RPS), 0, LEFT_DPAD},
+        // Triggers for command toggles
+        {"RX_", "", bit(BTN_RX), 0, bit(BTN_RPS)},
+        {"RO_", "", bit(BTN_RO), 0, bit(BTN_RPS)},
+        {"RL1_", "", bit(BTN_RL1), 0, bit(BTN_RL3)},
+        {"RX_", "", bit(BTN_RX), 0, bit(BTN_RL2)},
+        {"RO_", "", bit(BTN_RO), 0, bit(BTN_RL2)}};
+}
+
 namespace droid::controller {
     DualSonyNavController::DualSonyNavController(const char* name, droid::core::System* system) :
         Controller(name, system),
@@ -37,7 +86,7 @@ namespace droid::controller {
         PS3Left(&Btd) {
 
         if (DualSonyNavController::instance != NULL) {
-            logger->log(name, FATAL, "Constructor for DualSonyNavController called more than once!\n");
+            logger->log(logId, FATAL, "Constructor for DualSonyNavController called more than once!\n");
             while (1);  //TODO Better way to handle this???
         }
         DualSonyNavController::instance = this;
@@ -70,7 +119,7 @@ namespace droid::controller {
     }
 
     void DualSonyNavController::init() {
-        logger->log(name, INFO, "init - called\n");
+        LOGGER_LOG(logger, logId, INFO, "init - called\n");
         strncpy(PS3Right.MAC, config->getString(name, CONFIG_KEY_SONY_RIGHT_MAC, CONFIG_DEFAULT_SONY_RIGHT_MAC).c_str(), sizeof(PS3Right.MAC));
         strncpy(PS3Right.MACBackup, config->getString(name, CONFIG_KEY_SONY_ALT_RIGHT_MAC, CONFIG_DEFAULT_SONY_ALT_RIGHT_MAC).c_str(), sizeof(PS3Right.MACBackup));
         strncpy(PS3Left.MAC, config->getString(name, CONFIG_KEY_SONY_LEFT_MAC, CONFIG_DEFAULT_SONY_LEFT_MAC).c_str(), sizeof(PS3Left.MAC));
@@ -93,34 +142,37 @@ namespace droid::controller {
                 triggerMap[trigger] = override;
             }
         }
+        triggerTable.build(triggerMap, system->getActionNames(), buttonNames, BTN_COUNT,
+                           triggerLayers, sizeof(triggerLayers) / sizeof(triggerLayers[0]));
 
         if (Usb.Init() != 0) {
-            logger->log(name, FATAL, "Unable to init() the USB stack");
+            logger->log(logId, FATAL, "Unable to init() the USB stack");
         }
     }
 
     void DualSonyNavController::task() {
-        //logger->log(name, DEBUG, "task - called\n");
+        //LOGGER_LOG(logger, logId, DEBUG, "task - called\n");
         Usb.Task();
         faultCheck(&PS3Right);
         faultCheck(&PS3Left);
+        sample();
     }
 
     void DualSonyNavController::logConfig() {
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_RIGHT_MAC, config->getString(name, CONFIG_KEY_SONY_RIGHT_MAC, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_ALT_RIGHT_MAC, config->getString(name, CONFIG_KEY_SONY_ALT_RIGHT_MAC, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_LEFT_MAC, config->getString(name, CONFIG_KEY_SONY_LEFT_MAC, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_ALT_LEFT_MAC, config->getString(name, CONFIG_KEY_SONY_ALT_LEFT_MAC, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_ACTIVE_TIMEOUT, config->getString(name, CONFIG_KEY_SONY_ACTIVE_TIMEOUT, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_INACTIVE_TIMEOUT, config->getString(name, CONFIG_KEY_SONY_INACTIVE_TIMEOUT, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_BAD_DATA_WINDOW, config->getString(name, CONFIG_KEY_SONY_BAD_DATA_WINDOW, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_DEADBAND_X, config->getString(name, CONFIG_KEY_SONY_DEADBAND_X, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_DEADBAND_Y, config->getString(name, CONFIG_KEY_SONY_DEADBAND_Y, ""));
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_RIGHT_MAC, config->getString(name, CONFIG_KEY_SONY_RIGHT_MAC, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_ALT_RIGHT_MAC, config->getString(name, CONFIG_KEY_SONY_ALT_RIGHT_MAC, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_LEFT_MAC, config->getString(name, CONFIG_KEY_SONY_LEFT_MAC, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_ALT_LEFT_MAC, config->getString(name, CONFIG_KEY_SONY_ALT_LEFT_MAC, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_ACTIVE_TIMEOUT, config->getString(name, CONFIG_KEY_SONY_ACTIVE_TIMEOUT, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_INACTIVE_TIMEOUT, config->getString(name, CONFIG_KEY_SONY_INACTIVE_TIMEOUT, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_BAD_DATA_WINDOW, config->getString(name, CONFIG_KEY_SONY_BAD_DATA_WINDOW, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_DEADBAND_X, config->getString(name, CONFIG_KEY_SONY_DEADBAND_X, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SONY_DEADBAND_Y, config->getString(name, CONFIG_KEY_SONY_DEADBAND_Y, "").c_str());
 
         // Iterate through the triggerMap for keys to log
         for (const auto& mapEntry : triggerMap) {
             const char* trigger = mapEntry.first.c_str();
-            logger->log(name, INFO, "Config %s = %s\n", trigger, config->getString(name, trigger, "").c_str());
+            LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", trigger, config->getString(name, trigger, "").c_str());
         }
     }
 
@@ -140,7 +192,7 @@ namespace droid::controller {
         if (controller->ps3BT.PS3Connected || 
             controller->ps3BT.PS3NavigationConnected  || 
             controller->ps3BT.PS3MoveConnected) {
-            unsigned long now = millis();
+            unsigned long now = clock->millis();
             uint32_t origLastMsgTime = controller->lastMsgTime;
             uint32_t reportedLastMsgTime = controller->ps3BT.getLastMessageTime();
             if (reportedLastMsgTime > controller->lastMsgTime) {
@@ -163,15 +215,15 @@ namespace droid::controller {
 
             if (isCritical && 
                 (msgLagTime > activeTimeout)) {
-                logger->log(name, ERROR, "Timeout while controller active\n");
+                LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "Timeout while controller active\n");
             }
 
             if (msgLagTime > inactiveTimeout) {
                 uint32_t holdLastMsgTime = controller->lastMsgTime;
                 disconnect(controller);
                 controller->waitingForReconnect = true;
-                logger->log(name, ERROR, "Timeout while controller inactive\n");
-                logger->log(name, ERROR, "msgLag: %d, inactiveTimeout: %d, lastMsg: %d, origLastMsgTime: %d, deviceLastmsgTime: %d\n", msgLagTime, inactiveTimeout, holdLastMsgTime, origLastMsgTime, reportedLastMsgTime);
+                LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "Timeout while controller inactive\n");
+                LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "msgLag: %d, inactiveTimeout: %d, lastMsg: %d, origLastMsgTime: %d, deviceLastmsgTime: %d\n", msgLagTime, inactiveTimeout, holdLastMsgTime, origLastMsgTime, reportedLastMsgTime);
                 return;
             }
 
@@ -183,7 +235,7 @@ namespace droid::controller {
                 if (controller->badDataCount > 10) {
                     disconnect(controller);
                     controller->waitingForReconnect = true;
-                    logger->log(name, ERROR, "Too much bad data from Controller\n");
+                    LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "Too much bad data from Controller\n");
                 }
             } else {
                 if (controller->badDataCount > 0) {
@@ -193,7 +245,7 @@ namespace droid::controller {
         } else {
             controller->waitingForReconnect = true;
             controller->isConnected = false;
-            logger->log(name, ERROR, "Lost connection to Controller while Active\n");
+            LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "Lost connection to Controller while Active\n");
         }
     }
 
@@ -283,7 +335,7 @@ namespace droid::controller {
     }
 
     void DualSonyNavController::onInitPS3(Joystick which) {
-        logger->log(name, INFO, "DualSonyNavController::onInitPS3 called: %s\n", which == RIGHT ? "RIGHT" : "LEFT");
+        LOGGER_LOG(logger, logId, INFO, "DualSonyNavController::onInitPS3 called: %s\n", which == RIGHT ? "RIGHT" : "LEFT");
         ControllerDetails* controller;
         const char* whichStr;
         const char* configKey;
@@ -308,249 +360,62 @@ namespace droid::controller {
             addr[0], addr[1], addr[2], addr[3], addr[4], addr[5]);
 
         controller->ps3BT.setLedOn(LED1);
-        controller->lastMsgTime = millis();
+        controller->lastMsgTime = clock->millis();
         controller->isConnected = true;
 
-        logger->log(name, INFO, "Address of Last connected Device: %s\n", btAddr);
+        LOGGER_LOG(logger, logId, INFO, "Address of Last connected Device: %s\n", btAddr);
         
         if ((strncmp(btAddr, controller->MAC, sizeof(btAddr)) == 0) || 
             (strncmp(btAddr, controller->MACBackup, sizeof(btAddr)) == 0)) {
-            logger->log(name, INFO, "We have our %s controller connected.\n", whichStr);
+            LOGGER_LOG(logger, logId, INFO, "We have our %s controller connected.\n", whichStr);
         } else if (controller->MAC[0] == 'X') {
-            logger->log(name, INFO, "Assigning %s as %s controller.\n", btAddr, whichStr);
+            LOGGER_LOG(logger, logId, INFO, "Assigning %s as %s controller.\n", btAddr, whichStr);
             
             config->putString(name, configKey, btAddr);
             strncpy(controller->MAC, btAddr, sizeof(controller->MAC));
         } else {
             // Prevent connection from anything but the MAIN controllers          
-            logger->log(name, WARN, "We have an invalid controller trying to connect as the %s controller, it will be dropped.\n", whichStr);
+            logger->log(logId, WARN, "We have an invalid controller trying to connect as the %s controller, it will be dropped.\n", whichStr);
 
             controller->ps3BT.setLedOff(LED1);
             disconnect(controller);
         } 
     }
 
-    String DualSonyNavController::getAction() {
-        //Button definitions for Dual Sony Triggers to mimic PenumbraShadowMD
-        String trigger = getTrigger();
-        if (trigger == "") {    //No trigger detected
-            return "";
-        }
-        return triggerMap[trigger];
+    uint16_t DualSonyNavController::getAction(uint32_t buttons) {
+        return triggerTable.getAction(buttons);
     }
 
-    String DualSonyNavController::getTrigger() {
-        // Helper function to check for individual button presses
-        auto isButtonPressed = [this](ControllerDetails* thisController, ButtonEnum button) {
-            return thisController->isConnected &&
-                thisController->ps3BT.getButtonPress(button) &&
-                !thisController->ps3BT.getButtonPress(ButtonEnum::CROSS) &&
-                !thisController->ps3BT.getButtonPress(ButtonEnum::CIRCLE) &&
-                !thisController->ps3BT.getButtonPress(ButtonEnum::L1) &&
-                !thisController->ps3BT.getButtonPress(ButtonEnum::PS);
-        };
-
-        // Helper function to check for ANY modifier button press on 'other' controller
-        auto isModifierPressed = [this](ControllerDetails* otherController) {
-            return otherController->isConnected &&
-                (otherController->ps3BT.getButtonPress(ButtonEnum::CROSS) ||
-                otherController->ps3BT.getButtonPress(ButtonEnum::CIRCLE) ||
-                 otherController->ps3BT.getButtonPress(ButtonEnum::PS));
-        };
-
-        // Helper function to check for a button + modifier combo
-        // Note that if two controllers are active the modifier must be pressed on the 'other' controller
-        auto checkCombo = [this](ControllerDetails* thisController, ControllerDetails* otherController, ButtonEnum button, ButtonEnum modifier) {
-            return ((!otherController->isConnected && 
-                     thisController->isConnected && 
-                     thisController->ps3BT.getButtonPress(button) && 
-                     thisController->ps3BT.getButtonPress(modifier)) ||
-                    (otherController->isConnected && 
-                     thisController->isConnected &&
-                     thisController->ps3BT.getButtonPress(button) && 
-                     otherController->ps3BT.getButtonPress(modifier)));
-        };
-
-        // Helper function to check for a button + L1 combo
-        // Note that this is only looking for L1 on 'this' controller (not the 'other' one)
-        auto checkL1Combo = [this](ControllerDetails* thisController, ButtonEnum button) {
-            return (thisController->isConnected &&
-                    thisController->ps3BT.getButtonPress(button) && 
-                    thisController->ps3BT.getButtonPress(ButtonEnum::L1));
-        };
-
-        // Base button on Right controller
-        if (isButtonPressed(&PS3Right, ButtonEnum::UP) && !isModifierPressed(&PS3Left)) {
-            return "Rup";
-        }
-        if (isButtonPressed(&PS3Right, ButtonEnum::DOWN) && !isModifierPressed(&PS3Left)) {
-            return "Rdown";
-        }
-        if (isButtonPressed(&PS3Right, ButtonEnum::LEFT) && !isModifierPressed(&PS3Left)) {
-            return "Rleft";
-        }
-        if (isButtonPressed(&PS3Right, ButtonEnum::RIGHT) && !isModifierPressed(&PS3Left)) {
-            return "Rright";
-        }
-
-        // CROSS + base buttons on Right controller
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::UP, ButtonEnum::CROSS)) {
-            return "LX_Rup";
-        }
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::DOWN, ButtonEnum::CROSS)) {
-            return "LX_Rdown";
-        }
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::LEFT, ButtonEnum::CROSS)) {
-            return "LX_Rleft";
-        }
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::RIGHT, ButtonEnum::CROSS)) {
-            return "LX_Rright";
-        }
-
-        // CIRCLE + base buttons on Right controller
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::UP, ButtonEnum::CIRCLE)) {
-            return "LO_Rup";
-        }
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::DOWN, ButtonEnum::CIRCLE)) {
-            return "LO_Rdown";
-        }
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::LEFT, ButtonEnum::CIRCLE)) {
-            return "LO_Rleft";
-        }
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::RIGHT, ButtonEnum::CIRCLE)) {
-            return "LO_Rright";
-        }
-
-        // L1 + base buttons on Right controller
-        if (checkL1Combo(&PS3Right, ButtonEnum::UP)) {
-            return "RL1_Rup";
-        }
-        if (checkL1Combo(&PS3Right, ButtonEnum::DOWN)) {
-            return "RL1_Rdown";
-        }
-        if (checkL1Combo(&PS3Right, ButtonEnum::LEFT)) {
-            return "RL1_Rleft";
-        }
-        if (checkL1Combo(&PS3Right, ButtonEnum::RIGHT)) {
-            return "RL1_Rright";
-        }
-
-        // PS + base buttons on Right controller
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::UP, ButtonEnum::PS)) {
-            return "LPS_Rup";
-        }
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::DOWN, ButtonEnum::PS)) {
-            return "LPS_Rdown";
-        }
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::LEFT, ButtonEnum::PS)) {
-            return "LPS_Rleft";
-        }
-        if (checkCombo(&PS3Right, &PS3Left, ButtonEnum::RIGHT, ButtonEnum::PS)) {
-            return "LPS_Rright";
-        }
-
-        // Base button on Left controller
-        if (isButtonPressed(&PS3Left, ButtonEnum::UP) && !isModifierPressed(&PS3Right)) {
-            return "Lup";
-        }
-        if (isButtonPressed(&PS3Left, ButtonEnum::DOWN) && !isModifierPressed(&PS3Right)) {
-            return "Ldown";
-        }
-        if (isButtonPressed(&PS3Left, ButtonEnum::LEFT) && !isModifierPressed(&PS3Right)) {
-            return "Lleft";
-        }
-        if (isButtonPressed(&PS3Left, ButtonEnum::RIGHT) && !isModifierPressed(&PS3Right)) {
-            return "Lright";
-        }
-
-        // CROSS + base buttons on Left controller
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::UP, ButtonEnum::CROSS)) {
-            return "RX_Lup";
-        }
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::DOWN, ButtonEnum::CROSS)) {
-            return "RX_Ldown";
-        }
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::LEFT, ButtonEnum::CROSS)) {
-            return "RX_Lleft";
-        }
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::RIGHT, ButtonEnum::CROSS)) {
-            return "RX_Lright";
-        }
-
-        // CIRCLE + base buttons on Left controller
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::UP, ButtonEnum::CIRCLE)) {
-            return "RO_Lup";
-        }
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::DOWN, ButtonEnum::CIRCLE)) {
-            return "RO_Ldown";
-        }
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::LEFT, ButtonEnum::CIRCLE)) {
-            return "RO_Lleft";
-        }
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::RIGHT, ButtonEnum::CIRCLE)) {
-            return "RO_Lright";
-        }
-
-        // L1 + base buttons on Left controller
-        if (checkL1Combo(&PS3Left, ButtonEnum::UP)) {
-            return "LL1_Lup";
-        }
-        if (checkL1Combo(&PS3Left, ButtonEnum::DOWN)) {
-            return "LL1_Ldown";
-        }
-        if (checkL1Combo(&PS3Left, ButtonEnum::LEFT)) {
-            return "LL1_Lleft";
-        }
-        if (checkL1Combo(&PS3Left, ButtonEnum::RIGHT)) {
-            return "LL1_Lright";
-        }
-
-        // PS + base buttons on Left controller
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::UP, ButtonEnum::PS)) {
-            return "RPS_Lup";
-        }
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::DOWN, ButtonEnum::PS)) {
-            return "RPS_Ldown";
-        }
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::LEFT, ButtonEnum::PS)) {
-            return "RPS_Lleft";
-        }
-        if (checkCombo(&PS3Left, &PS3Right, ButtonEnum::RIGHT, ButtonEnum::PS)) {
-            return "RPS_Lright";
-        }
+    uint32_t DualSonyNavController::readButtons() {
+        uint32_t right = readButtons(&PS3Right);
+        uint32_t left = readButtons(&PS3Left);
+        uint32_t buttons = right | (left << LEFT_SHIFT);
+        // With only one controller connected its own modifiers stand in for the 'other' controller's,
+        // but only with its dpad (the only single controller combos), so that they can never
+        // complete a trigger of the missing controller, such as RX_RPS.
+        // right and left are both still in the Right layout here.
+        if (!PS3Left.isConnected && ((right & RIGHT_DPAD) != 0)) {
+            buttons |= (right & SHARED_MODIFIERS) << LEFT_SHIFT;
+        }
+        if (!PS3Right.isConnected && ((left & RIGHT_DPAD) != 0)) {
+            buttons |= (left & SHARED_MODIFIERS);
+        }
+        return buttons;
+    }
 
-        // Triggers for command toggles
-        if (PS3Right.isConnected && 
-            PS3Right.ps3BT.getButtonPress(ButtonEnum::PS) && 
-            PS3Right.ps3BT.getButtonPress(ButtonEnum::CROSS)) {
-            return "RX_RPS";
-        }
-        
-        if(PS3Right.isConnected && 
-            PS3Right.ps3BT.getButtonPress(ButtonEnum::PS) && 
-            PS3Right.ps3BT.getButtonPress(ButtonEnum::CIRCLE)) {
-            return "RO_RPS";
+    uint32_t DualSonyNavController::readButtons(ControllerDetails* controller) {
+        if (!controller->isConnected) {
+            return 0;
         }
-        
-        if (PS3Right.isConnected && 
-            PS3Right.ps3BT.getButtonPress(ButtonEnum::L3) && 
-            PS3Right.ps3BT.getButtonPress(ButtonEnum::L1)) {
-            return "RL1_RL3";
+        uint32_t buttons = 0;
+        uint8_t button = 0;
+        for (ButtonEnum pressButton : pressButtons) {
+            if (controller->ps3BT.getButtonPress(pressButton)) {
+                buttons |= bit(button);
+            }
+            button++;
         }
-    
-        if(PS3Right.isConnected && 
-            PS3Right.ps3BT.getButtonPress(ButtonEnum::L2) && 
-            PS3Right.ps3BT.getButtonPress(ButtonEnum::CROSS)) {
-            return "RX_RL2";
-        } 
-
-        if(PS3Right.isConnected && 
-            PS3Right.ps3BT.getButtonPress(ButtonEnum::L2) && 
-            PS3Right.ps3BT.getButtonPress(ButtonEnum::CIRCLE)) {
-            return "RO_RL2";
-        } 
-
-        return String("");
+        return buttons;
     }
 
     DualSonyNavController* DualSonyNavController::instance = NULL;
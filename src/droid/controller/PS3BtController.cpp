@@ -26,6 +26,50 @@
 #define CONFIG_DEFAULT_PS3_BAD_DATA_WINDOW  50
 #define CONFIG_DEFAULT_PS3_DEADBAND         20
 
+namespace {
+    //Bit number of each button in the mask returned by readButtons()
+    enum TriggerButton : uint8_t {
+        BTN_START, BTN_SELECT, BTN_PS, BTN_L3, BTN_R3,
+        BTN_CROSS, BTN_CIRCLE, BTN_SQUARE, BTN_TRIANGLE,
+        BTN_UP, BTN_DOWN, BTN_LEFT, BTN_RIGHT,
+        BTN_L1, BTN_R1, BTN_L2, BTN_R2,
+        BTN_COUNT};
+
+    //Read with getButtonClick(), in bit order
+    const ButtonEnum clickButtons[] = {
+        ButtonEnum::START, ButtonEnum::SELECT, ButtonEnum::PS, ButtonEnum::L3, ButtonEnum::R3,
+        ButtonEnum::CROSS, ButtonEnum::CIRCLE, ButtonEnum::SQUARE, ButtonEnum::TRIANGLE,
+        ButtonEnum::UP, ButtonEnum::DOWN, ButtonEnum::LEFT, ButtonEnum::RIGHT};
+
+    //Read with getButtonPress(), in bit order following the clickButtons
+    const ButtonEnum modifierButtons[] = {
+        ButtonEnum::L1, ButtonEnum::R1, ButtonEnum::L2, ButtonEnum::R2};
+
+    const char* const buttonNames[BTN_COUNT] = {
+        "Start", "Select", "P3", "L3", "R3",
+        "Cross", "Circle", "Square", "Triangle",
+        "Up", "Down", "Left", "Right",
+        "L1", "R1", "L2", "R2"};
+
+    const uint32_t MODIFIERS = bit(BTN_L1) | bit(BTN_R1) | bit(BTN_L2) | bit(BTN_R2);
+    const uint32_t BUTTONS = bit(BTN_CROSS) | bit(BTN_CIRCLE) | bit(BTN_SQUARE) | bit(BTN_TRIANGLE) |
+                             bit(BTN_UP) | bit(BTN_DOWN) | bit(BTN_LEFT) | bit(BTN_RIGHT);
+
+    //Button definitions for PS3 Triggers, in priority order
+    const droid::controller::TriggerLayer triggerLayers[] = {
+        // Special buttons first
+        {"", "", 0, 0, bit(BTN_START)},
+        {"", "_R2", bit(BTN_R2), MODIFIERS & ~bit(BTN_R2), bit(BTN_SELECT)},
+        {"", "", 0, 0, bit(BTN_SELECT) | bit(BTN_PS) | bit(BTN_L3) | bit(BTN_R3)},
+        // Unmodified button presses
+        {"", "", 0, MODIFIERS, BUTTONS},
+        // Exactly one modifier + button presses
+        {"L1_", "", bit(BTN_L1), MODIFIERS & ~bit(BTN_L1), BUTTONS},
+        {"R1_", "", bit(BTN_R1), MODIFIERS & ~bit(BTN_R1), BUTTONS},
+        {"L2_", "", bit(BTN_L2), MODIFIERS & ~bit(BTN_L2), BUTTONS},
+        {"R2_", "", bit(BTN_R2), MODIFIERS & ~bit(BTN_R2), BUTTONS}};
+}
+
 namespace droid::controller {
     PS3BtController::PS3BtController(const char* name, droid::core::System* system) :
         Controller(name, system),
@@ -34,7 +78,7 @@ namespace droid::controller {
         PS3(&Btd) {
 
         if (PS3BtController::instance != NULL) {
-            logger->log(name, FATAL, "Constructor for PS3Controller called more than once!\n");
+            logger->log(logId, FATAL, "Constructor for PS3Controller called more than once!\n");
             while (1);  //TODO Better way to handle this???
         }
         PS3BtController::instance = this;
@@ -64,7 +108,7 @@ namespace droid::controller {
     }
 
     void PS3BtController::init() {
-        logger->log(name, INFO, "init - called\n");
+        LOGGER_LOG(logger, logId, INFO, "init - called\n");
         strncpy(PS3.MAC, config->getString(name, CONFIG_KEY_PS3_MAC, CONFIG_DEFAULT_PS3_MAC).c_str(), sizeof(PS3.MAC));
         strncpy(PS3.MACBackup, config->getString(name, CONFIG_KEY_PS3_ALT_MAC, CONFIG_DEFAULT_PS3_ALT_MAC).c_str(), sizeof(PS3.MACBackup));
         activeTimeout = config->getInt(name, CONFIG_KEY_PS3_ACTIVE_TIMEOUT, CONFIG_DEFAULT_PS3_ACTIVE_TIMEOUT);
@@ -85,31 +129,34 @@ namespace droid::controller {
                 triggerMap[trigger] = override;
             }
         }
+        triggerTable.build(triggerMap, system->getActionNames(), buttonNames, BTN_COUNT,
+                           triggerLayers, sizeof(triggerLayers) / sizeof(triggerLayers[0]));
 
         if (Usb.Init() != 0) {
-            logger->log(name, FATAL, "Unable to init() the USB stack");
+            logger->log(logId, FATAL, "Unable to init() the USB stack");
         }
     }
 
     void PS3BtController::task() {
-        //logger->log(name, DEBUG, "task - called\n");
+        //LOGGER_LOG(logger, logId, DEBUG, "task - called\n");
         Usb.Task();
         faultCheck(&PS3);
+        sample();
     }
 
     void PS3BtController::logConfig() {
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_MAC, config->getString(name, CONFIG_KEY_PS3_MAC, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_ALT_MAC, config->getString(name, CONFIG_KEY_PS3_ALT_MAC, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_ACTIVE_TIMEOUT, config->getString(name, CONFIG_KEY_PS3_ACTIVE_TIMEOUT, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_INACTIVE_TIMEOUT, config->getString(name, CONFIG_KEY_PS3_INACTIVE_TIMEOUT, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_BAD_DATA_WINDOW, config->getString(name, CONFIG_KEY_PS3_BAD_DATA_WINDOW, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_DEADBAND_X, config->getString(name, CONFIG_KEY_PS3_DEADBAND_X, ""));
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_DEADBAND_Y, config->getString(name, CONFIG_KEY_PS3_DEADBAND_Y, ""));
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_MAC, config->getString(name, CONFIG_KEY_PS3_MAC, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_ALT_MAC, config->getString(name, CONFIG_KEY_PS3_ALT_MAC, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_ACTIVE_TIMEOUT, config->getString(name, CONFIG_KEY_PS3_ACTIVE_TIMEOUT, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_INACTIVE_TIMEOUT, config->getString(name, CONFIG_KEY_PS3_INACTIVE_TIMEOUT, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_BAD_DATA_WINDOW, config->getString(name, CONFIG_KEY_PS3_BAD_DATA_WINDOW, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_DEADBAND_X, config->getString(name, CONFIG_KEY_PS3_DEADBAND_X, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_PS3_DEADBAND_Y, config->getString(name, CONFIG_KEY_PS3_DEADBAND_Y, "").c_str());
 
         // Iterate through the triggerMap for keys to log
         for (const auto& mapEntry : triggerMap) {
             const char* trigger = mapEntry.first.c_str();
-            logger->log(name, INFO, "Config %s = %s\n", trigger, config->getString(name, trigger, "").c_str());
+            LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", trigger, config->getString(name, trigger, "").c_str());
         }
     }
 
@@ -129,7 +176,7 @@ namespace droid::controller {
         if (controller->ps3BT.PS3Connected || 
             controller->ps3BT.PS3NavigationConnected  || 
             controller->ps3BT.PS3MoveConnected) {
-            unsigned long now = millis();
+            unsigned long now = clock->millis();
             uint32_t origLastMsgTime = controller->lastMsgTime;
             uint32_t reportedLastMsgTime = controller->ps3BT.getLastMessageTime();
             if (reportedLastMsgTime > controller->lastMsgTime) {
@@ -152,15 +199,15 @@ namespace droid::controller {
 
             if (isCritical && 
                 (msgLagTime > activeTimeout)) {
-                logger->log(name, ERROR, "Timeout while controller active\n");
+                LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "Timeout while controller active\n");
             }
 
             if (msgLagTime > inactiveTimeout) {
                 uint32_t holdLastMsgTime = controller->lastMsgTime;
                 disconnect(controller);
                 controller->waitingForReconnect = true;
-                logger->log(name, ERROR, "Timeout while controller inactive\n");
-                logger->log(name, ERROR, "msgLag: %d, inactiveTimeout: %d, lastMsg: %d, origLastMsgTime: %d, deviceLastmsgTime: %d\n", msgLagTime, inactiveTimeout, holdLastMsgTime, origLastMsgTime, reportedLastMsgTime);
+                LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "Timeout while controller inactive\n");
+                LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "msgLag: %d, inactiveTimeout: %d, lastMsg: %d, origLastMsgTime: %d, deviceLastmsgTime: %d\n", msgLagTime, inactiveTimeout, holdLastMsgTime, origLastMsgTime, reportedLastMsgTime);
                 return;
             }
 
@@ -172,7 +219,7 @@ namespace droid::controller {
                 if (controller->badDataCount > 10) {
                     disconnect(controller);
                     controller->waitingForReconnect = true;
-                    logger->log(name, ERROR, "Too much bad data from Controller\n");
+                    LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "Too much bad data from Controller\n");
                 }
             } else {
                 if (controller->badDataCount > 0) {
@@ -182,7 +229,7 @@ namespace droid::controller {
         } else {
             controller->waitingForReconnect = true;
             controller->isConnected = false;
-            logger->log(name, ERROR, "Lost connection to Controller while Active\n");
+            LOGGER_LOG_LIMITED(logger, logId, ERROR, LOGGER_LIMIT_FAULT_MS, LOGGER_LIMIT_FAULT_BURST, "Lost connection to Controller while Active\n");
         }
     }
 
@@ -239,7 +286,7 @@ namespace droid::controller {
     }
 
     void PS3BtController::onInitPS3() {
-        logger->log(name, INFO, "PS3Controller::onInitPS3 called.\n");
+        LOGGER_LOG(logger, logId, INFO, "PS3Controller::onInitPS3 called.\n");
 
         char btAddr[20];
         uint8_t* addr = Btd.disc_bdaddr;
@@ -247,152 +294,51 @@ namespace droid::controller {
             addr[0], addr[1], addr[2], addr[3], addr[4], addr[5]);
 
         PS3.ps3BT.setLedOn(LED1);
-        PS3.lastMsgTime = millis();
+        PS3.lastMsgTime = clock->millis();
         PS3.isConnected = true;
 
-        logger->log(name, INFO, "Address of Last connected Device: %s\n", btAddr);
+        LOGGER_LOG(logger, logId, INFO, "Address of Last connected Device: %s\n", btAddr);
         
         if ((strncmp(btAddr, PS3.MAC, sizeof(btAddr)) == 0) || 
             (strncmp(btAddr, PS3.MACBackup, sizeof(btAddr)) == 0)) {
-            logger->log(name, INFO, "We have our controller connected.\n");
+            LOGGER_LOG(logger, logId, INFO, "We have our controller connected.\n");
         } else if (PS3.MAC[0] == 'X') {
-            logger->log(name, INFO, "Assigning %s as controller.\n", btAddr);
+            LOGGER_LOG(logger, logId, INFO, "Assigning %s as controller.\n", btAddr);
             
             config->putString(name, CONFIG_KEY_PS3_MAC, btAddr);
             strncpy(PS3.MAC, btAddr, sizeof(PS3.MAC));
         } else {
             // Prevent connection from anything but the MAIN controllers          
-            logger->log(name, WARN, "We have an invalid controller trying to connect, it will be dropped.\n");
+            logger->log(logId, WARN, "We have an invalid controller trying to connect, it will be dropped.\n");
 
             PS3.ps3BT.setLedOff(LED1);
             disconnect(&PS3);
         } 
     }
 
-    String PS3BtController::getAction() {
-        //Button definitions for Dual Sony Triggers to mimic PenumbraShadowMD
-        String trigger = getTrigger();
-        if (trigger == "") {    //No trigger detected
-            return "";
-        }
-        return triggerMap[trigger];
+    uint16_t PS3BtController::getAction(uint32_t buttons) {
+        return triggerTable.getAction(buttons);
     }
 
-    String PS3BtController::getTrigger() {
-        // Helper function to check for L1 modifier button press
-        auto isL1Pressed = [this]() {
-            return PS3.isConnected &&
-                PS3.ps3BT.getButtonPress(ButtonEnum::L1) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::R1) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::L2) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::R2);
-        };
-
-        // Helper function to check for R1 modifier button press
-        auto isR1Pressed = [this]() {
-            return PS3.isConnected &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::L1) &&
-                PS3.ps3BT.getButtonPress(ButtonEnum::R1) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::L2) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::R2);
-        };
-
-        // Helper function to check for L2 modifier button press
-        auto isL2Pressed = [this]() {
-            return PS3.isConnected &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::L1) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::R1) &&
-                PS3.ps3BT.getButtonPress(ButtonEnum::L2) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::R2);
-        };
-
-        // Helper function to check for R2 modifier button press
-        auto isR2Pressed = [this]() {
-            return PS3.isConnected &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::L1) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::R1) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::L2) &&
-                PS3.ps3BT.getButtonPress(ButtonEnum::R2);
-        };
-
-        // Helper function to check for no modifier button presses
-        auto noModifiersPressed = [this]() {
-            return PS3.isConnected &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::L1) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::R1) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::L2) &&
-                !PS3.ps3BT.getButtonPress(ButtonEnum::R2);
-        };
-
-        // Check for special buttons first
-        if (PS3.ps3BT.getButtonClick(ButtonEnum::START)) {return "Start";}
-        if (PS3.ps3BT.getButtonClick(ButtonEnum::SELECT) && isR2Pressed()) {return "Select_R2";}
-        if (PS3.ps3BT.getButtonClick(ButtonEnum::SELECT)) {return "Select";}
-        if (PS3.ps3BT.getButtonClick(ButtonEnum::PS)) {return "P3";}
-        if (PS3.ps3BT.getButtonClick(ButtonEnum::L3)) {return "L3";}
-        if (PS3.ps3BT.getButtonClick(ButtonEnum::R3)) {return "R3";}
-
-        // Check for unmodified button presses
-        if (noModifiersPressed()) {
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::CROSS)) {return "Cross";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::CIRCLE)) {return "Circle";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::SQUARE)) {return "Square";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::TRIANGLE)) {return "Triangle";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::UP)) {return "Up";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::DOWN)) {return "Down";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::LEFT)) {return "Left";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::RIGHT)) {return "Right";}
-        }
-
-        // Check L1 + button presses
-        if (isL1Pressed()) {
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::CROSS)) {return "L1_Cross";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::CIRCLE)) {return "L1_Circle";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::SQUARE)) {return "L1_Square";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::TRIANGLE)) {return "L1_Triangle";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::UP)) {return "L1_Up";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::DOWN)) {return "L1_Down";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::LEFT)) {return "L1_Left";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::RIGHT)) {return "L1_Right";}
-        }
-
-        // Check R1 + button presses
-        if (isR1Pressed()) {
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::CROSS)) {return "R1_Cross";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::CIRCLE)) {return "R1_Circle";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::SQUARE)) {return "R1_Square";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::TRIANGLE)) {return "R1_Triangle";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::UP)) {return "R1_Up";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::DOWN)) {return "R1_Down";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::LEFT)) {return "R1_Left";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::RIGHT)) {return "R1_Right";}
+    uint32_t PS3BtController::readButtons() {
+        if (!PS3.isConnected) {
+            return 0;
         }
-
-        // Check L2 + button presses
-        if (isL2Pressed()) {
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::CROSS)) {return "L2_Cross";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::CIRCLE)) {return "L2_Circle";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::SQUARE)) {return "L2_Square";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::TRIANGLE)) {return "L2_Triangle";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::UP)) {return "L2_Up";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::DOWN)) {return "L2_Down";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::LEFT)) {return "L2_Left";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::RIGHT)) {return "L2_Right";}
+        uint32_t buttons = 0;
+        uint8_t button = 0;
+        for (ButtonEnum clickButton : clickButtons) {
+            if (PS3.ps3BT.getButtonClick(clickButton)) {
+                buttons |= bit(button);
+            }
+            button++;
         }
-
-        // Check R2 + button presses
-        if (isR2Pressed()) {
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::CROSS)) {return "R2_Cross";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::CIRCLE)) {return "R2_Circle";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::SQUARE)) {return "R2_Square";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::TRIANGLE)) {return "R2_Triangle";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::UP)) {return "R2_Up";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::DOWN)) {return "R2_Down";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::LEFT)) {return "R2_Left";}
-            if (PS3.ps3BT.getButtonClick(ButtonEnum::RIGHT)) {return "R2_Right";}
+        for (ButtonEnum modifierButton : modifierButtons) {
+            if (PS3.ps3BT.getButtonPress(modifierButton)) {
+                buttons |= bit(button);
+            }
+            button++;
         }
-
-        return String("");
+        return buttons;
     }
 
     PS3BtController* PS3BtController::instance = NULL;
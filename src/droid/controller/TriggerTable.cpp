@@ -0,0 +1,125 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include "droid/controller/TriggerTable.h"
+
+namespace droid::controller {
+
+    void TriggerTable::build(const std::map<String, String>& triggerMap, droid::core::NameTable* actionNames,
+                             const char* const* buttonNames, uint8_t buttonCount,
+                             const TriggerLayer* layers, uint8_t layerCount) {
+        modifierBits.clear();
+        rowIndex.clear();
+        rows.clear();
+        cells.clear();
+        buttonCount = min(buttonCount, (uint8_t) TRIGGERTABLE_MAX_BUTTONS);
+
+        //Resolve every trigger name once, in priority order
+        std::vector<uint16_t> layerActions;
+        uint32_t modifierMask = 0;
+        for (uint8_t layer = 0; layer < layerCount; layer++) {
+            modifierMask |= layers[layer].required | layers[layer].forbidden;
+            for (uint8_t button = 0; button < buttonCount; button++) {
+                if (layers[layer].bases & (1UL << button)) {
+                    char trigger[40];
+                    snprintf(trigger, sizeof(trigger), "%s%s%s", layers[layer].prefix, buttonNames[button], layers[layer].suffix);
+                    auto mapEntry = triggerMap.find(trigger);
+                    if (mapEntry == triggerMap.end()) {
+                        layerActions.push_back(NAMETABLE_NONE);
+                    } else {
+                        layerActions.push_back(actionNames->intern(mapEntry->second.c_str()));
+                    }
+                }
+            }
+        }
+        for (uint8_t button = 0; (button < 32) && (modifierBits.size() < TRIGGERTABLE_MAX_MODIFIERS); button++) {
+            if (modifierMask & (1UL << button)) {
+                modifierBits.push_back(button);
+            }
+        }
+
+        //One row per combination of pressed modifiers, identical rows are shared
+        rowIndex.resize(1 << modifierBits.size());
+        for (size_t combo = 0; combo < rowIndex.size(); combo++) {
+            uint32_t pressed = 0;
+            for (size_t index = 0; index < modifierBits.size(); index++) {
+                if (combo & (1 << index)) {
+                    pressed |= (1UL << modifierBits[index]);
+                }
+            }
+
+            Cell rowCells[TRIGGERTABLE_MAX_BUTTONS];
+            uint32_t bases = 0;
+            uint16_t rank = 0;
+            for (uint8_t layer = 0; layer < layerCount; layer++) {
+                bool matches = ((pressed & layers[layer].required) == layers[layer].required) &&
+                               ((pressed & layers[layer].forbidden) == 0);
+                for (uint8_t button = 0; button < buttonCount; button++) {
+                    if (layers[layer].bases & (1UL << button)) {
+                        //An earlier layer already claimed this button for these modifiers
+                        if (matches && !(bases & (1UL << button))) {
+                            bases |= (1UL << button);
+                            rowCells[button] = {layerActions[rank], rank};
+                        }
+                        rank++;
+                    }
+                }
+            }
+
+            Row row = {bases, (uint16_t) cells.size()};
+            for (uint8_t button = 0; button < buttonCount; button++) {
+                if (bases & (1UL << button)) {
+                    cells.push_back(rowCells[button]);
+                }
+            }
+            size_t cellCount = cells.size() - row.first;
+            size_t found = 0;
+            while ((found < rows.size()) &&
+                   ((rows[found].bases != bases) ||
+                    (memcmp(&cells[rows[found].first], &cells[row.first], cellCount * sizeof(Cell)) != 0))) {
+                found++;
+            }
+            if (found < rows.size()) {
+                cells.resize(row.first);
+            } else {
+                rows.push_back(row);
+            }
+            rowIndex[combo] = found;
+        }
+    }
+
+    uint16_t TriggerTable::getAction(uint32_t buttons) const {
+        if (rows.empty()) {
+            return NAMETABLE_NONE;
+        }
+        uint16_t combo = 0;
+        for (size_t index = 0; index < modifierBits.size(); index++) {
+            if (buttons & (1UL << modifierBits[index])) {
+                combo |= (1 << index);
+            }
+        }
+        const Row& row = rows[rowIndex[combo]];
+
+        //Usually only one base button is down, otherwise the lowest rank wins
+        uint32_t candidates = buttons & row.bases;
+        uint16_t action = NAMETABLE_NONE;
+        uint16_t bestRank = UINT16_MAX;
+        while (candidates != 0) {
+            uint8_t button = __builtin_ctz(candidates);
+            candidates &= (candidates - 1);
+            const Cell& cell = cells[row.first + __builtin_popcount(row.bases & ((1UL << button) - 1))];
+            if (cell.rank < bestRank) {
+                bestRank = cell.rank;
+                action = cell.action;
+            }
+        }
+        return action;
+    }
+}
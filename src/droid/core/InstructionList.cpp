@@ -12,68 +12,74 @@
 
 namespace droid::core {
 
+    InstructionList::InstructionList() {
+        clear();
+    }
+
+    bool InstructionList::isEarlier(const Instruction* a, const Instruction* b) {
+        //Wrap-safe comparisons, millis() rolls over every ~49 days
+        long timeDiff = (long) (a->executeTime - b->executeTime);
+        if (timeDiff != 0) {
+            return timeDiff < 0;
+        }
+        return (int32_t) (a->sequence - b->sequence) < 0;
+    }
+
     void InstructionList::dump(const char* name, Logger* logger, LogLevel level) {
-        int i = 0;
-        Instruction* instruction = head;
-        while (instruction != NULL) {
-            logger->log(name, level, "InstructionList[%d] device: %s, cmd: %s\n", i, instruction->device, instruction->command);
-            i++;
-            instruction = instruction->next;
+        for (uint8_t i = 0; i < count; i++) {
+            logger->log(name, level, "InstructionList[%d] device: %s, cmd: %s, time: %lu\n", i, heap[i]->device, heap[i]->command, heap[i]->executeTime);
         }
     }
 
     void InstructionList::clear() {
-        Instruction* instruction = head;
-        while (instruction != NULL) {
-            instruction = deleteInstruction(instruction);
+        for (uint8_t index = 0; index < INSTRUCTIONLIST_QUEUE_SIZE; index++) {
+            list[index].command[0] = 0;
+            list[index].device[0] = 0;
+            list[index].executeTime = 0;
+            list[index].isActive = false;
+            //Hand out the low indexes first
+            freeList[index] = INSTRUCTIONLIST_QUEUE_SIZE - 1 - index;
         }
+        freeCount = INSTRUCTIONLIST_QUEUE_SIZE;
+        count = 0;
     }
 
-    Instruction* InstructionList::addInstruction() {
-        Instruction* freeRec = NULL;
-        uint8_t index;
-        for (index = 0; index < INSTRUCTIONLIST_QUEUE_SIZE; index++) {
-            if (!list[index].isActive) {
-                freeRec = &list[index];
-                break;
-            }
-        }
-        if (freeRec == NULL) {  //List is full
+    Instruction* InstructionList::addInstruction(unsigned long executeTime) {
+        if (freeCount == 0) {   //List is full
             return NULL;
         }
-        //link prev record to this one
-        if (tail != NULL) {
-            tail->next = freeRec;
-        }
+        freeCount--;
+        Instruction* freeRec = &list[freeList[freeCount]];
+
         //Prepare record for reuse
+        freeRec->command[0] = 0;
+        freeRec->device[0] = 0;
+        freeRec->executeTime = executeTime;
+        freeRec->sequence = nextSequence++;
+        freeRec->target = INSTRUCTIONLIST_NO_TARGET;
         freeRec->isActive = true;
-        freeRec->prev = tail;       //Always add to end of list
-        freeRec->next = NULL;
-        tail = freeRec;
-        if (head == NULL) {   //List was empty
-            head = freeRec;
-        }
+
+        heap[count] = freeRec;
+        count++;
+        siftUp(count - 1);
         return freeRec;
     }
 
-    Instruction* InstructionList::deleteInstruction(Instruction* entry) {
-        if (entry == NULL) {
-            return NULL;
-        }
-        if (head == NULL) {
-            return NULL;
-        }
-        if (entry->prev == NULL) {   //Was first entry in list
-            head = entry->next;
-        } else {
-            entry->prev->next = entry->next;
-        }
-        if (tail == entry) {    //Was last entry in list
-            tail = entry->prev;
+    bool InstructionList::isDue(unsigned long now) const {
+        return (count > 0) && ((long) (now - heap[0]->executeTime) >= 0);
+    }
+
+    bool InstructionList::popDue(unsigned long now, Instruction& out) {
+        if (!isDue(now)) {
+            return false;
         }
-        Instruction* next = entry->next;
-        if (next != NULL) {
-            next->prev = entry->prev;
+        Instruction* entry = heap[0];
+        out = *entry;
+
+        count--;
+        if (count > 0) {
+            heap[0] = heap[count];
+            siftDown(0);
         }
 
         //Clear record for reuse
@@ -81,20 +87,40 @@ namespace droid::core {
         entry->device[0] = 0;
         entry->executeTime = 0;
         entry->isActive = false;
-        entry->next = NULL;
-        entry->prev = NULL;
-
-        return next;
+        freeList[freeCount] = entry - list;
+        freeCount++;
+        return true;
     }
 
-    Instruction* InstructionList::initLoop() {
-        return head;
+    void InstructionList::siftUp(uint8_t index) {
+        Instruction* entry = heap[index];
+        while (index > 0) {
+            uint8_t parent = (index - 1) / 2;
+            if (!isEarlier(entry, heap[parent])) {
+                break;
+            }
+            heap[index] = heap[parent];
+            index = parent;
+        }
+        heap[index] = entry;
     }
 
-    Instruction* InstructionList::getNext(Instruction* entry) {
-        if (entry == NULL) {
-            return NULL;
+    void InstructionList::siftDown(uint8_t index) {
+        Instruction* entry = heap[index];
+        while (true) {
+            uint16_t child = (2 * index) + 1;
+            if (child >= count) {
+                break;
+            }
+            if ((child + 1 < count) && isEarlier(heap[child + 1], heap[child])) {
+                child++;
+            }
+            if (!isEarlier(heap[child], entry)) {
+                break;
+            }
+            heap[index] = heap[child];
+            index = child;
         }
-        return entry->next;
+        heap[index] = entry;
     }
 }
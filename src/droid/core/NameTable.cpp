@@ -0,0 +1,52 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include "droid/core/NameTable.h"
+
+namespace droid::core {
+
+    NameTable::NameTable() {
+        names.push_back("");    //NAMETABLE_NONE
+    }
+
+    uint16_t NameTable::intern(const char* name) {
+        if ((name == NULL) || (name[0] == 0)) {
+            return NAMETABLE_NONE;
+        }
+        uint16_t id = find(name);
+        if ((id != NAMETABLE_NONE) || (names.size() > UINT16_MAX)) {
+            return id;
+        }
+        size_t len = strlen(name) + 1;
+        char* copy = new char[len];
+        memcpy(copy, name, len);
+        names.push_back(copy);
+        return names.size() - 1;
+    }
+
+    uint16_t NameTable::find(const char* name) const {
+        if ((name == NULL) || (name[0] == 0)) {
+            return NAMETABLE_NONE;
+        }
+        for (size_t id = 1; id < names.size(); id++) {
+            if (strcmp(names[id], name) == 0) {
+                return id;
+            }
+        }
+        return NAMETABLE_NONE;
+    }
+
+    const char* NameTable::getName(uint16_t id) const {
+        if (id >= names.size()) {
+            return "";
+        }
+        return names[id];
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include "droid/core/Scheduler.h"
+#include <algorithm>
+
+namespace {
+    //Wrap-safe comparison of two micros() timestamps
+    inline bool isBefore(uint32_t a, uint32_t b) {
+        return (int32_t) (a - b) < 0;
+    }
+}
+
+namespace droid::core {
+
+    Scheduler::Scheduler(Logger* logger, Clock* clock, Config* config, TimerService* timers, uint32_t taskDeadlineMicros) :
+        logger(logger),
+        clock(clock),
+        config(config),
+        timers(timers),
+        timerLane(timers->addLane()),
+        taskDeadlineMicros(taskDeadlineMicros) {}
+
+    void Scheduler::add(BaseComponent* component) {
+        ScheduledTask task;
+        task.component = component;
+        component->setTimerLane(timerLane);
+        task.schedule = component->getSchedule();
+        task.stats.setDeadline(taskDeadlineMicros);
+        tasks.push_back(task);
+        order.push_back(tasks.size() - 1);
+        dueList.reserve(tasks.size());
+    }
+
+    void Scheduler::start() {
+        start(clock->micros());
+    }
+
+    void Scheduler::start(uint32_t now) {
+        for (ScheduledTask& task : tasks) {
+            task.nextRun = now + task.schedule.phaseMicros;
+        }
+        sortOrder();
+    }
+
+    void Scheduler::run() {
+        run(clock->micros());
+    }
+
+    void Scheduler::run(uint32_t now) {
+        uint32_t changes = config->getChangeCount();
+        if (changes != configChanges) {
+            configChanges = changes;
+            for (ScheduledTask& task : tasks) {
+                config->dispatch(task.component);
+            }
+        }
+        timers->run(timerLane);
+
+        //order is sorted by nextRun, so the due tasks are a prefix of it
+        dueList.clear();
+        for (uint8_t index : order) {
+            if (isBefore(now, tasks[index].nextRun)) {
+                break;
+            }
+            dueList.push_back(index);
+        }
+        if (dueList.empty()) {
+            return;
+        }
+
+        //Run the due tasks by priority, then by earliest deadline
+        std::sort(dueList.begin(), dueList.end(), [this](uint8_t a, uint8_t b) {
+            const ScheduledTask& taskA = tasks[a];
+            const ScheduledTask& taskB = tasks[b];
+            if (taskA.schedule.priority != taskB.schedule.priority) {
+                return taskA.schedule.priority < taskB.schedule.priority;
+            }
+            return isBefore(taskA.nextRun + taskA.schedule.periodMicros, taskB.nextRun + taskB.schedule.periodMicros);
+        });
+        for (uint8_t index : dueList) {
+            runTask(tasks[index], now);
+        }
+        sortOrder();
+    }
+
+    void Scheduler::runTask(ScheduledTask& task, uint32_t now) {
+        uint32_t begin = micros();
+        task.component->task();
+        uint32_t time = micros() - begin;
+        task.stats.record(time);
+        if (time > taskDeadlineMicros) {
+            logger->log(task.component->name, WARN, "subTask took %lu micros to execute!\n", (unsigned long) time);
+        }
+
+        uint32_t period = task.schedule.periodMicros;
+        if (period == 0) {
+            task.nextRun = now;
+            return;
+        }
+        task.nextRun += period;
+        if (isBefore(task.nextRun, now)) {
+            //Fell behind by one or more whole periods, skip them but keep the phase.
+            //  Landing exactly on the next deadline is on time, that run is simply due now.
+            uint32_t missed = ((now - task.nextRun) / period) + 1;
+            task.nextRun += missed * period;
+            task.overruns += missed;
+        }
+    }
+
+    void Scheduler::resetStats() {
+        for (ScheduledTask& task : tasks) {
+            task.stats.reset();
+            task.overruns = 0;
+        }
+    }
+
+    void Scheduler::sortOrder() {
+        //Insertion sort, order is almost sorted already so this is close to linear
+        for (size_t i = 1; i < order.size(); i++) {
+            uint8_t index = order[i];
+            size_t j = i;
+            while ((j > 0) && isBefore(tasks[index].nextRun, tasks[order[j - 1]].nextRun)) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = index;
+        }
+    }
+}
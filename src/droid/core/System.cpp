@@ -11,9 +11,15 @@
 #include "droid/core/System.h"
 
 namespace droid::core {
-    System::System(Stream* logStream, LogLevel defaultLogLevel) :
-        logger(logStream, defaultLogLevel),
-        config("Config", &logger) {}
+    System::System(Stream* logStream, LogLevel defaultLogLevel, Clock* clock) :
+        clock(clock ? clock : &realClock),
+        config("Config", &logger, this->clock),
+        logger(logStream, defaultLogLevel, this->clock),
+        timers(this->clock) {}
+
+    Clock* System::getClock() {
+        return clock;
+    }
 
     Config* System::getConfig() {
         return &config;
@@ -27,6 +33,14 @@ namespace droid::core {
         return &droidState;
     }
 
+    NameTable* System::getActionNames() {
+        return &actionNames;
+    }
+
+    TimerService* System::getTimers() {
+        return &timers;
+    }
+
     void System::setPWMService(droid::services::PWMService* pwmService) {
         this->pwmService = pwmService;
     }
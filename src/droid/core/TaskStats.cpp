@@ -0,0 +1,88 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use. 
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include "droid/core/TaskStats.h"
+
+namespace droid::core {
+
+    void TaskStats::record(uint32_t micros) {
+        buckets[bucketFor(micros)]++;
+        count++;
+        totalMicros += micros;
+        if (micros > maxMicros) {
+            maxMicros = micros;
+        }
+        if ((deadlineMicros != 0) && (micros > deadlineMicros)) {
+            deadlineMisses++;
+        }
+    }
+
+    void TaskStats::reset() {
+        memset(buckets, 0, sizeof(buckets));
+        count = 0;
+        maxMicros = 0;
+        totalMicros = 0;
+        deadlineMisses = 0;
+    }
+
+    void TaskStats::setDeadline(uint32_t micros) {
+        deadlineMicros = micros;
+    }
+
+    uint32_t TaskStats::getMean() const {
+        if (count == 0) {
+            return 0;
+        }
+        return totalMicros / count;
+    }
+
+    uint32_t TaskStats::getPercentile(uint8_t percent) const {
+        if (count == 0) {
+            return 0;
+        }
+        if (percent > 100) {
+            percent = 100;
+        }
+        //Rank of the sample we are looking for (1 based, rounded up)
+        uint32_t rank = (((uint64_t) count * percent) + 99) / 100;
+        if (rank == 0) {
+            rank = 1;
+        }
+        uint32_t seen = 0;
+        for (uint8_t bucket = 0; bucket < TASKSTATS_BUCKET_COUNT; bucket++) {
+            seen += buckets[bucket];
+            if (seen >= rank) {
+                return std::min(bucketUpperBound(bucket), maxMicros);
+            }
+        }
+        return maxMicros;
+    }
+
+    uint8_t TaskStats::bucketFor(uint32_t micros) {
+        if (micros < TASKSTATS_LINEAR_LIMIT) {
+            return micros;
+        }
+        if (micros >= (1UL << TASKSTATS_MAX_BITS)) {
+            return TASKSTATS_BUCKET_COUNT - 1;
+        }
+        uint8_t msb = 31 - __builtin_clz(micros);      //msb >= 3 here
+        uint8_t sub = (micros >> (msb - 2)) & (TASKSTATS_SUB_BUCKETS - 1);
+        return TASKSTATS_LINEAR_LIMIT + ((msb - 3) * TASKSTATS_SUB_BUCKETS) + sub;
+    }
+
+    uint32_t TaskStats::bucketUpperBound(uint8_t bucket) {
+        if (bucket < TASKSTATS_LINEAR_LIMIT) {
+            return bucket;
+        }
+        uint8_t msb = ((bucket - TASKSTATS_LINEAR_LIMIT) / TASKSTATS_SUB_BUCKETS) + 3;
+        uint8_t sub = (bucket - TASKSTATS_LINEAR_LIMIT) % TASKSTATS_SUB_BUCKETS;
+        return (((uint32_t) (TASKSTATS_SUB_BUCKETS + sub + 1)) << (msb - 2)) - 1;
+    }
+}
@@ -0,0 +1,162 @@
+/*
+ * MechMind Program
+ * Author: Kizmit99
+ * License: CC BY-NC-SA 4.0
+ *
+ * This source code is open-source for non-commercial use.
+ * For commercial use, please obtain a license from the author.
+ * For more information, visit https://github.com/kizmit99/MechMind
+ */
+
+#include "droid/core/TimerService.h"
+
+namespace {
+    //Wrap-safe comparison of two millis() timestamps
+    inline bool isBefore(uint32_t a, uint32_t b) {
+        return (int32_t) (a - b) < 0;
+    }
+}
+
+namespace droid::core {
+
+    TimerService::TimerService(Clock* clock) :
+        clock(clock) {}
+
+    //TIMER_LANE_NONE once TIMERSERVICE_MAX_LANES are in use, the timers of that Scheduler can not be created
+    uint8_t TimerService::addLane() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (laneCount >= TIMERSERVICE_MAX_LANES) {
+            return TIMER_LANE_NONE;
+        }
+        return laneCount++;
+    }
+
+    TimerId TimerService::create(TimerListener* listener, uint8_t lane) {
+        std::lock_guard<std::mutex> guard(lock);
+        if ((lane >= TIMERSERVICE_MAX_LANES) || (timerCount >= TIMERSERVICE_MAX_TIMERS)) {
+            return TIMER_NONE;
+        }
+        Timer& timer = timers[timerCount];
+        timer.listener = listener;
+        timer.lane = lane;
+        return timerCount++;
+    }
+
+    void TimerService::start(TimerId timer, uint32_t delayMs, uint32_t periodMs) {
+        if (timer >= timerCount) {
+            return;
+        }
+        uint32_t now = clock->millis();
+        std::lock_guard<std::mutex> guard(lock);
+        remove(timer);
+        timers[timer].dueAt = now + delayMs;
+        timers[timer].periodMs = periodMs;
+        insert(timer);
+        publish(lanes[timers[timer].lane]);
+    }
+
+    void TimerService::cancel(TimerId timer) {
+        if (timer >= timerCount) {
+            return;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        remove(timer);
+        publish(lanes[timers[timer].lane]);
+    }
+
+    bool TimerService::isRunning(TimerId timer) {
+        if (timer >= timerCount) {
+            return false;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        return timers[timer].running;
+    }
+
+    uint32_t TimerService::getDueAt(TimerId timer) {
+        if (timer >= timerCount) {
+            return 0;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        return timers[timer].dueAt;
+    }
+
+    void TimerService::run(uint8_t lane) {
+        run(lane, clock->millis());
+    }
+
+    void TimerService::run(uint8_t laneId, uint32_t now) {
+        if (laneId >= TIMERSERVICE_MAX_LANES) {
+            return;
+        }
+        Lane& lane = lanes[laneId];
+        if ((lane.pending.load(std::memory_order_acquire) == 0) ||
+            isBefore(now, lane.firstDueAt.load(std::memory_order_relaxed))) {
+            return;
+        }
+
+        //Collect the due timers of this lane, the callbacks are made without the lock
+        TimerId fired[TIMERSERVICE_MAX_TIMERS];
+        uint8_t firedCount = 0;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            while ((lane.runningCount > 0) && !isBefore(now, timers[lane.order[0]].dueAt)) {
+                TimerId timer = lane.order[0];
+                remove(timer);
+                fired[firedCount++] = timer;
+            }
+            for (uint8_t count = 0; count < firedCount; count++) {
+                Timer& timer = timers[fired[count]];
+                if (timer.periodMs != 0) {
+                    //Skip the periods that were missed, but keep the phase
+                    timer.dueAt += timer.periodMs;
+                    if (!isBefore(now, timer.dueAt)) {
+                        timer.dueAt += (((now - timer.dueAt) / timer.periodMs) + 1) * timer.periodMs;
+                    }
+                    insert(fired[count]);
+                }
+            }
+            publish(lane);
+        }
+        for (uint8_t count = 0; count < firedCount; count++) {
+            timers[fired[count]].listener->timerExpired(fired[count]);
+        }
+    }
+
+    //Called with the lock held
+    void TimerService::insert(TimerId timer) {
+        Lane& lane = lanes[timers[timer].lane];
+        uint8_t index = lane.runningCount;
+        while ((index > 0) && isBefore(timers[timer].dueAt, timers[lane.order[index - 1]].dueAt)) {
+            lane.order[index] = lane.order[index - 1];
+            index--;
+        }
+        lane.order[index] = timer;
+        lane.runningCount++;
+        timers[timer].running = true;
+    }
+
+    //Called with the lock held
+    void TimerService::remove(TimerId timer) {
+        if (!timers[timer].running) {
+            return;
+        }
+        Lane& lane = lanes[timers[timer].lane];
+        uint8_t index = 0;
+        while (lane.order[index] != timer) {
+            index++;
+        }
+        lane.runningCount--;
+        for (; index < lane.runningCount; index++) {
+            lane.order[index] = lane.order[index + 1];
+        }
+        timers[timer].running = false;
+    }
+
+    //Called with the lock held, after the lane's order changed
+    void TimerService::publish(Lane& lane) {
+        if (lane.runningCount > 0) {
+            lane.firstDueAt.store(timers[lane.order[0]].dueAt, std::memory_order_relaxed);
+        }
+        lane.pending.store(lane.runningCount, std::memory_order_release);
+    }
+}
@@ -22,9 +22,20 @@ namespace droid::motor {
         wrapped(address, *port, initialByte) {}
 
     void CytronSmartDriveDuoDriver::init() {
+        loadConfig();
+        config->subscribe(name, NULL, this);
+        timeoutTimer = createTimer();
+        stop();
+    }
+
+    void CytronSmartDriveDuoDriver::configChanged(const char* nspace, const char* key) {
+        loadConfig();
+        LOGGER_LOG(logger, logId, INFO, "Config reloaded\n");
+    }
+
+    void CytronSmartDriveDuoDriver::loadConfig() {
         timeoutMs = config->getInt(name, CONFIG_KEY_CYTRON_TIMEOUT, CONFIG_DEFAULT_CYTRON_TIMEOUT);
         deadband = config->getInt(name, CONFIG_KEY_CYTRON_DEADBAND, CONFIG_DEFAULT_CYTRON_DEADBAND);
-        stop();
     }
 
     void CytronSmartDriveDuoDriver::factoryReset() {
@@ -34,17 +45,19 @@ namespace droid::motor {
     }
 
     void CytronSmartDriveDuoDriver::task() {
-        ulong now = millis();
-        if (((motorSpeed[0] != 0) || (motorSpeed[1] != 0)) && 
-            (now > (lastCommandMs + timeoutMs))) {
-            logger->log(name, WARN, "task - timeout happened now=%d, lastCmd=%d, timeout=%d\n", now, lastCommandMs, timeoutMs);
+        //NOOP, the command timeout is a timer
+    }
+
+    void CytronSmartDriveDuoDriver::timerExpired(droid::core::TimerId timer) {
+        if ((motorSpeed[0] != 0) || (motorSpeed[1] != 0)) {
+            logger->log(logId, WARN, "timeout happened now=%lu, lastCmd=%lu, timeout=%d\n", clock->millis(), lastCommandMs, timeoutMs);
             stop();
         }
     }
 
     void CytronSmartDriveDuoDriver::logConfig() {
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_CYTRON_TIMEOUT, config->getString(name, CONFIG_KEY_CYTRON_TIMEOUT, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_CYTRON_DEADBAND, config->getString(name, CONFIG_KEY_CYTRON_DEADBAND, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_CYTRON_TIMEOUT, config->getString(name, CONFIG_KEY_CYTRON_TIMEOUT, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_CYTRON_DEADBAND, config->getString(name, CONFIG_KEY_CYTRON_DEADBAND, "").c_str());
     }
 
     void CytronSmartDriveDuoDriver::failsafe() {
@@ -55,52 +68,56 @@ namespace droid::motor {
     // And speed should be specified in the normalized range from -100 to +100
     bool CytronSmartDriveDuoDriver::setMotorSpeed(uint8_t motor, int8_t speed) {
         if (motor > 1) {return false;}
-        if (speed < -100) {speed = -100;}
-        if (speed > 100) {speed = 100;}
-        if (abs(speed) <= deadband) {
-            speed = 0;
-        }
-        lastCommandMs = millis();
-
-        int8_t nativeSpeed = map(speed, -100, 100, -128, 127);
-        if (speed == 0) {
-            nativeSpeed = 0;
-        }
-        motorSpeed[motor] = nativeSpeed;
+        if (timeoutTimer == TIMER_NONE) {return false;}     //Never move without the command timeout
+        bool wasMoving = isMoving();
+        lastCommandMs = clock->millis();
+        motorSpeed[motor] = toNative(speed);
         
         wrapped.motor(motorSpeed[0], motorSpeed[1]);
+        armTimeout(wasMoving);
         return true;
     }
 
-    //Joystick positions specified as normalized values between -100 and +100
-    bool CytronSmartDriveDuoDriver::arcadeDrive(int8_t joystickX, int8_t joystickY) {
-        if (joystickX < -100) {joystickX = -100;}
-        if (joystickX > 100) {joystickX = 100;}
-        if (joystickY < -100) {joystickY = -100;}
-        if (joystickY > 100) {joystickY = 100;}
-        lastCommandMs = millis();
-        // Scale joystick inputs to motor output ranges 
-        int forward = joystickY; // Forward/backward control 
-        int turn = joystickX; // Left/right control 
-        
-        // Calculate the motor speeds based on joystick input 
-        int leftMotorSpeed = forward + turn; 
-        int rightMotorSpeed = forward - turn; 
-        
-        // Ensure the motor speeds are within the valid range (-127 to 128) 
-        leftMotorSpeed = std::max(-100, std::min(100, leftMotorSpeed)); 
-        rightMotorSpeed = std::max(-100, std::min(100, rightMotorSpeed));
-
-        bool supported = true;
-        supported &= setMotorSpeed(0, leftMotorSpeed);
-        supported &= setMotorSpeed(1, rightMotorSpeed);
-        return supported;
+    //Both speeds go out in the one packet, rather than one packet per motor
+    bool CytronSmartDriveDuoDriver::setMotorSpeeds(int8_t leftSpeed, int8_t rightSpeed) {
+        if (timeoutTimer == TIMER_NONE) {return false;}     //Never move without the command timeout
+        bool wasMoving = isMoving();
+        lastCommandMs = clock->millis();
+        motorSpeed[0] = toNative(leftSpeed);
+        motorSpeed[1] = toNative(rightSpeed);
+
+        wrapped.motor(motorSpeed[0], motorSpeed[1]);
+        armTimeout(wasMoving);
+        return true;
+    }
+
+    bool CytronSmartDriveDuoDriver::isMoving() {
+        return (motorSpeed[0] != 0) || (motorSpeed[1] != 0);
+    }
+
+    //Moving motors are stopped if no new command comes within timeoutMs
+    void CytronSmartDriveDuoDriver::armTimeout(bool wasMoving) {
+        if (isMoving()) {
+            timers->start(timeoutTimer, timeoutMs);
+        } else if (wasMoving) {
+            timers->cancel(timeoutTimer);
+        }
+    }
+
+    int8_t CytronSmartDriveDuoDriver::toNative(int8_t speed) {
+        if (speed < -100) {speed = -100;}
+        if (speed > 100) {speed = 100;}
+        if (abs(speed) <= deadband) {
+            return 0;
+        }
+        return map(speed, -100, 100, -128, 127);
     }
 
     void CytronSmartDriveDuoDriver::stop() {
         wrapped.stop();
         motorSpeed[0] = 0;
         motorSpeed[1] = 0;
-        lastCommandMs = millis();
+        lastCommandMs = clock->millis();
+        timers->cancel(timeoutTimer);
     }
 }
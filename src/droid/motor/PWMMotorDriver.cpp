@@ -32,17 +32,29 @@ namespace droid::motor {
     }
 
     void PWMMotorDriver::init() {
+        loadConfig();
+        config->subscribe(name, NULL, this);
+        motorDetails[0].commandTimer = createTimer();
+        motorDetails[1].commandTimer = createTimer();
+        motorDetails[0].requestedDutyCycle = 0;
+        setDutyCycle(0, 0);
+        motorDetails[1].requestedDutyCycle = 0;
+        setDutyCycle(1, 0);
+    }
+
+    void PWMMotorDriver::configChanged(const char* nspace, const char* key) {
+        loadConfig();
+        LOGGER_LOG(logger, logId, INFO, "Config reloaded\n");
+    }
+
+    void PWMMotorDriver::loadConfig() {
         motorDetails[0].timeoutMs = config->getInt(name, CONFIG_KEY_PWMMOTOR_TIMEOUT, CONFIG_DEFAULT_PWMMOTOR_TIMEOUT);
         motorDetails[0].deadband = config->getInt(name, CONFIG_KEY_PWMMOTOR_DEADBAND, CONFIG_DEFAULT_PWMMOTOR_DEADBAND);
         motorDetails[0].rampPowerPerMs = config->getFloat(name, CONFIG_KEY_PWMMOTOR_RAMP, CONFIG_DEFAULT_PWMMOTOR_RAMP);
-        motorDetails[0].requestedDutyCycle = 0;
-        setDutyCycle(0, 0);
 
         motorDetails[1].timeoutMs = motorDetails[0].timeoutMs;
         motorDetails[1].deadband = motorDetails[0].deadband;
         motorDetails[1].rampPowerPerMs = motorDetails[0].rampPowerPerMs;
-        motorDetails[1].requestedDutyCycle = 0;
-        setDutyCycle(1, 0);
     }
 
     void PWMMotorDriver::factoryReset() {
@@ -53,9 +65,9 @@ namespace droid::motor {
     }
 
     void PWMMotorDriver::logConfig() {
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_PWMMOTOR_TIMEOUT, config->getString(name, CONFIG_KEY_PWMMOTOR_TIMEOUT, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_PWMMOTOR_DEADBAND, config->getString(name, CONFIG_KEY_PWMMOTOR_DEADBAND, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_PWMMOTOR_RAMP, config->getString(name, CONFIG_KEY_PWMMOTOR_RAMP, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_PWMMOTOR_TIMEOUT, config->getString(name, CONFIG_KEY_PWMMOTOR_TIMEOUT, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_PWMMOTOR_DEADBAND, config->getString(name, CONFIG_KEY_PWMMOTOR_DEADBAND, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_PWMMOTOR_RAMP, config->getString(name, CONFIG_KEY_PWMMOTOR_RAMP, "").c_str());
     }
 
     void PWMMotorDriver::failsafe() {
@@ -69,66 +81,69 @@ namespace droid::motor {
     //Speed should be specified in the range -100 to +100
     bool PWMMotorDriver::setMotorSpeed(uint8_t motor, int8_t speed) {
         if (motor > 1) {return false;}
+        requestSpeed(motor, speed);
+        task();
+        return true;
+    }
+
+    //Both motors are ramped by the one task() pass
+    bool PWMMotorDriver::setMotorSpeeds(int8_t leftSpeed, int8_t rightSpeed) {
+        requestSpeed(0, leftSpeed);
+        requestSpeed(1, rightSpeed);
+        task();
+        return true;
+    }
+
+    void PWMMotorDriver::requestSpeed(uint8_t motor, int8_t speed) {
         if (speed < -100) {speed = -100;}
         if (speed > 100) {speed = 100;}
         if (abs(speed) <= motorDetails[motor].deadband) {
             speed = 0;
         }
+        //Without its timeout a motor could keep running after commands stop, so it stays stopped
+        if (motorDetails[motor].commandTimer == TIMER_NONE) {
+            speed = 0;
+        }
 
-        motorDetails[motor].lastCommandMs = millis();
+        //A moving motor is stopped if no new command comes within its timeout
+        if (speed != 0) {
+            timers->start(motorDetails[motor].commandTimer, motorDetails[motor].timeoutMs);
+        } else if (motorDetails[motor].requestedDutyCycle != 0) {
+            timers->cancel(motorDetails[motor].commandTimer);
+        }
+        motorDetails[motor].lastCommandMs = clock->millis();
         motorDetails[motor].requestedDutyCycle = speed;
-        task();
-        return true;
     }
 
-    //Joystick positions should be passed as normalized (-100 to +100)
-    bool PWMMotorDriver::arcadeDrive(int8_t joystickX, int8_t joystickY) {
-        if (joystickX < -100) {joystickX = -100;}
-        if (joystickX > 100) {joystickX = 100;}
-        if (joystickY < -100) {joystickY = -100;}
-        if (joystickY > 100) {joystickY = 100;}
-        // Scale joystick inputs to motor output ranges 
-        int forward = joystickY; // Forward/backward control 
-        int turn = joystickX; // Left/right control 
-        
-        // Calculate the motor speeds based on joystick input 
-        int leftMotorSpeed = forward + turn; 
-        int rightMotorSpeed = forward - turn; 
-        
-        // Ensure the motor speeds are within the valid range (-100 to 100) 
-        leftMotorSpeed = std::max(-100, std::min(100, leftMotorSpeed)); 
-        rightMotorSpeed = std::max(-100, std::min(100, rightMotorSpeed));
-
-        bool supported = true;
-        supported &= setMotorSpeed(0, leftMotorSpeed);
-        supported &= setMotorSpeed(1, rightMotorSpeed);
-        return supported;
+    void PWMMotorDriver::timerExpired(droid::core::TimerId timer) {
+        ulong now = clock->millis();
+        for (uint8_t motor = 0; motor < 2; motor++) {
+            if ((timer == motorDetails[motor].commandTimer) && (motorDetails[motor].requestedDutyCycle != 0)) {
+                logger->log(logId, WARN, "timeout happened now=%lu, lastCmd=%lu, timeout=%d\n", now, motorDetails[motor].lastCommandMs, motorDetails[motor].timeoutMs);
+                motorDetails[motor].requestedDutyCycle = 0;
+                motorDetails[motor].lastCommandMs = now;
+            }
+        }
     }
-    
+
     void PWMMotorDriver::stop() {
-        setMotorSpeed(0, 0);
-        setMotorSpeed(1, 0);
+        setMotorSpeeds(0, 0);
     }
 
     void PWMMotorDriver::task() {
-        ulong now = millis();
+        ulong now = clock->millis();
         for (uint8_t motor = 0; motor < 2; motor++) {
-            if ((motorDetails[motor].requestedDutyCycle != 0) && (now > (motorDetails[motor].lastCommandMs + motorDetails[motor].timeoutMs))) {
-                logger->log(name, WARN, "task - timeout happened now=%d, lastCmd=%d, timeout=%d\n", now, motorDetails[motor].lastCommandMs, motorDetails[motor].timeoutMs);
-                motorDetails[motor].requestedDutyCycle = 0;
-                motorDetails[motor].lastCommandMs = now;
-            }
             if (motorDetails[motor].lastUpdateMs > now) {
                 motorDetails[motor].lastUpdateMs = now;
             }
             if (motorDetails[motor].requestedDutyCycle != motorDetails[motor].currentDutyCycle) {
-                logger->log(name, DEBUG, "task - motor=%d, requestedDutyCycle=%d, currentDutyCycle=%d\n", motor, motorDetails[motor].requestedDutyCycle, motorDetails[motor].currentDutyCycle);
+                LOGGER_LOG_LIMITED(logger, logId, DEBUG, LOGGER_LIMIT_TICK_MS, LOGGER_LIMIT_TICK_BURST, "task - motor=%d, requestedDutyCycle=%d, currentDutyCycle=%d\n", motor, motorDetails[motor].requestedDutyCycle, motorDetails[motor].currentDutyCycle);
                 int16_t delta = abs(motorDetails[motor].currentDutyCycle - motorDetails[motor].requestedDutyCycle);
                 int16_t maxDelta = (int16_t) ((now - motorDetails[motor].lastUpdateMs) * motorDetails[motor].rampPowerPerMs);
                 if (delta > maxDelta) {
                     delta = maxDelta;
                 }
-                logger->log(name, DEBUG, "task - delta=%d, maxDelta=%d\n", delta, maxDelta);
+                LOGGER_LOG_LIMITED(logger, logId, DEBUG, LOGGER_LIMIT_TICK_MS, LOGGER_LIMIT_TICK_BURST, "task - delta=%d, maxDelta=%d\n", delta, maxDelta);
                 if (delta > 0) {
                     if (motorDetails[motor].currentDutyCycle > motorDetails[motor].requestedDutyCycle) {
                         motorDetails[motor].currentDutyCycle = max(-100, motorDetails[motor].currentDutyCycle - delta);
@@ -148,7 +163,7 @@ namespace droid::motor {
     }
 
     void PWMMotorDriver::setDutyCycle(uint8_t motor, int8_t dutyCycle) {
-//        logger->log(name, DEBUG, "setDutyCycle motor: %d, dutyCycle: %d\n", motor, dutyCycle);
+//        LOGGER_LOG(logger, logId, DEBUG, "setDutyCycle motor: %d, dutyCycle: %d\n", motor, dutyCycle);
         if ((motorDetails[motor].out1 < 0) || (motorDetails[motor].out2 < 0)) {
             return;
         }
@@ -166,4 +181,4 @@ namespace droid::motor {
             }
         }
     }
-}
\ No newline at end of file
+}
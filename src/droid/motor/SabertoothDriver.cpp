@@ -44,7 +44,10 @@ namespace droid::motor {
     SabertoothDriver::SabertoothDriver(const char* name, droid::core::System* system, byte address, Stream* port) :
         MotorDriver(name, system),
         port(port),
-        wrapped(address, *port) {}
+        wrapped(address, *port) {
+        //Speeds are sent directly from setMotorSpeed, task() has nothing to do
+        setSchedule(SCHEDULE_HOUSEKEEPING_PERIOD_US, 0, SCHEDULE_PRIORITY_HOUSEKEEPING);
+    }
 
     void SabertoothDriver::init() {
         uint32_t timeoutMs = config->getInt(name, CONFIG_KEY_SABERTOOTH_TIMEOUT, CONFIG_DEFAULT_SABERTOOTH_TIMEOUT);
@@ -75,11 +78,11 @@ namespace droid::motor {
     }
     
     void SabertoothDriver::logConfig() {
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SABERTOOTH_TIMEOUT, config->getString(name, CONFIG_KEY_SABERTOOTH_TIMEOUT, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SABERTOOTH_DEADBAND, config->getString(name, CONFIG_KEY_SABERTOOTH_DEADBAND, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SABERTOOTH_RAMP, config->getString(name, CONFIG_KEY_SABERTOOTH_RAMP, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SABERTOOTH_MIN_VOLTAGE, config->getString(name, CONFIG_KEY_SABERTOOTH_MIN_VOLTAGE, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_SABERTOOTH_MAX_VOLTAGE, config->getString(name, CONFIG_KEY_SABERTOOTH_MAX_VOLTAGE, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SABERTOOTH_TIMEOUT, config->getString(name, CONFIG_KEY_SABERTOOTH_TIMEOUT, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SABERTOOTH_DEADBAND, config->getString(name, CONFIG_KEY_SABERTOOTH_DEADBAND, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SABERTOOTH_RAMP, config->getString(name, CONFIG_KEY_SABERTOOTH_RAMP, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SABERTOOTH_MIN_VOLTAGE, config->getString(name, CONFIG_KEY_SABERTOOTH_MIN_VOLTAGE, "").c_str());
+        LOGGER_LOG(logger, logId, INFO, "Config %s = %s\n", CONFIG_KEY_SABERTOOTH_MAX_VOLTAGE, config->getString(name, CONFIG_KEY_SABERTOOTH_MAX_VOLTAGE, "").c_str());
     }
     
     void SabertoothDriver::failsafe() {
@@ -96,8 +99,8 @@ namespace droid::motor {
 
         //Throttle motor updates when resending the same speed as last time
         if ((speed != lastMotorSpeed[motor]) ||
-            (millis() > (lastMotorUpdate[motor] + SABERTOOTH_UPDATE_THROTTLE))) {
-            lastMotorUpdate[motor] = millis();
+            (clock->millis() > (lastMotorUpdate[motor] + SABERTOOTH_UPDATE_THROTTLE))) {
+            lastMotorUpdate[motor] = clock->millis();
             int8_t nativeSpeed = map(speed, -100, 100, -128, 127);
             if (speed == 0) {
                 nativeSpeed = 0;
@@ -105,38 +108,13 @@ namespace droid::motor {
             wrapped.motor(motor + 1, nativeSpeed);
         }
         if (speed != lastMotorSpeed[motor]) {
-            logger->log(name, DEBUG, "setMotorSpeed(%d, %d)\n", motor, speed);
+            LOGGER_LOG(logger, logId, DEBUG, "setMotorSpeed(%d, %d)\n", motor, speed);
         }
         lastMotorSpeed[motor] = speed;
         return true;
     }
     
-    //Joystick positions specified as normalized values between -100 and +100
-    bool SabertoothDriver::arcadeDrive(int8_t joystickX, int8_t joystickY) {
-        if (joystickX < -100) {joystickX = -100;}
-        if (joystickX > 100) {joystickX = 100;}
-        if (joystickY < -100) {joystickY = -100;}
-        if (joystickY > 100) {joystickY = 100;}
-        // Scale joystick inputs to motor output ranges 
-        int forward = joystickY; // Forward/backward control 
-        int turn = joystickX; // Left/right control 
-        
-        // Calculate the motor speeds based on joystick input 
-        int leftMotorSpeed = forward + turn; 
-        int rightMotorSpeed = forward - turn; 
-        
-        // Ensure the motor speeds are within the valid range (-100 to 100) 
-        leftMotorSpeed = std::max(-100, std::min(100, leftMotorSpeed)); 
-        rightMotorSpeed = std::max(-100, std::min(100, rightMotorSpeed));
-
-        bool supported = true;
-        supported &= setMotorSpeed(0, leftMotorSpeed);
-        supported &= setMotorSpeed(1, rightMotorSpeed);
-        return supported;
-    }
-    
     void SabertoothDriver::stop() {
-        setMotorSpeed(0, 0);
-        setMotorSpeed(1, 0);
+        setMotorSpeeds(0, 0);
     }
 }
\ No newline at end of file
@@ -8,34 +8,66 @@
  * For more information, visit https://github.com/kizmit99/MechMind
  */
 
+#define LOGGER_FLOOR LOGGER_FLOOR_PCA9685
 #include "droid/services/PCA9685PWM.h"
 #include "settings/hardware.config.h"
 
 namespace droid::services {
     PCA9685PWM::PCA9685PWM(const char* name, droid::core::System* system, const uint8_t I2CAddress, uint8_t outputEnablePin) :
-        PWMService(name, system),
-        outputEnablePin(outputEnablePin),
-        pca9685Driver(I2CAddress) {}
+        PCA9685PWM(name, system, I2CAddress, Wire, outputEnablePin) {}
 
     PCA9685PWM::PCA9685PWM(const char* name, droid::core::System* system, const uint8_t I2CAddress, TwoWire &i2c, uint8_t outputEnablePin) :
         PWMService(name, system),
-        outputEnablePin(outputEnablePin),
-        pca9685Driver(I2CAddress, i2c) {}
+        i2c(&i2c),
+        outputEnablePin(outputEnablePin) {
+        //Every control tick, after the motor drivers have set their outputs
+        setSchedule(SCHEDULE_CONTROL_PERIOD_US, 0, SCHEDULE_PRIORITY_NORMAL);
+        addBoard(I2CAddress, PCA9685_PWM_FREQ_HZ);
+    }
+
+    PCA9685PWM::PCA9685PWM(const char* name, droid::core::System* system, const PCA9685BoardConfig* boardConfigs, uint8_t boardCount, TwoWire &i2c, uint8_t outputEnablePin) :
+        PWMService(name, system),
+        i2c(&i2c),
+        outputEnablePin(outputEnablePin) {
+        setSchedule(SCHEDULE_CONTROL_PERIOD_US, 0, SCHEDULE_PRIORITY_NORMAL);
+        for (uint8_t index = 0; index < boardCount; index++) {
+            addBoard(boardConfigs[index].address, boardConfigs[index].frequencyHz);
+        }
+    }
+
+    void PCA9685PWM::addBoard(uint8_t address, uint16_t frequencyHz) {
+        if (boardCount >= PCA9685_MAX_BOARDS) {
+            return;
+        }
+        Board& board = boards[boardCount++];
+        board.driver = new Adafruit_PWMServoDriver(address, *i2c);
+        board.address = address;
+        board.frequencyHz = frequencyHz;
+    }
 
     void PCA9685PWM::init() {
-        if (pca9685Driver.begin()) {
-            logger->log(name, DEBUG, "begin method successful!\n");
-            pca9685Driver.setOscillatorFrequency(PCA9685_OSC_FREQUENCY);
-            pca9685Driver.setPWMFreq(PCA9685_PWM_FREQ_HZ);
-            pca9685Driver.setOutputMode(true);
-            if (outputEnablePin != 0) {
-                pinMode(outputEnablePin, OUTPUT);
-                digitalWrite(outputEnablePin, LOW);
+        disableTimer = createTimer();
+        bool anyInitialized = false;
+        for (uint8_t index = 0; index < boardCount; index++) {
+            Board& board = boards[index];
+            if (board.driver->begin()) {
+                board.driver->setOscillatorFrequency(PCA9685_OSC_FREQUENCY);
+                //Also turns on register auto-increment, used by the burst writes of flushBoard()
+                board.driver->setPWMFreq(board.frequencyHz);
+                board.driver->setOutputMode(true);
+                board.prescale = board.driver->readPrescale();
+                board.initialized = true;
+                anyInitialized = true;
+                LOGGER_LOG(logger, logId, DEBUG, "board 0x%02x begin method successful, freq=%d, prescale=%d\n", board.address, board.frequencyHz, board.prescale);
+            } else {
+                board.initialized = false;
+                LOGGER_LOG(logger, logId, DEBUG, "board 0x%02x begin method failed, outputs %d to %d are disabled\n", board.address, index * PWM_OUTPUTS_PER_BOARD, (index + 1) * PWM_OUTPUTS_PER_BOARD - 1);
             }
-            initialized = true;
-        } else {
-            logger->log(name, DEBUG, "begin method failed!");
-            initialized = false;
+        }
+        if (outputEnablePin != 0) {
+            //Outputs stay disabled when no board came up
+            pinMode(outputEnablePin, OUTPUT);
+            digitalWrite(outputEnablePin, anyInitialized ? LOW : HIGH);
         }
     }
 
@@ -43,27 +75,54 @@ namespace droid::services {
         //NOOP
     }
 
+    //The only place outputs are written after init(), so the I2C bus has a single owner
+    //  (the control task) and the main loop never waits on a burst, nor holds one up
     void PCA9685PWM::task() {
-        if (!initialized) return;
-        uint32_t now = millis();
-        for (int i = 0; i < NUMBER_OF_PWM_OUTPUTS; i++) {
-            if (outDetails[i].isActive &&
-                (outDetails[i].disableAt != 0) &&
-                (now >= outDetails[i].disableAt)) {
-                logger->log(name, DEBUG, "disabling PWM output %d after timeout\n", i);
-                pca9685Driver.setPin(i, 0);
-                outDetails[i].disableAt = 0;
-                outDetails[i].isActive = false;
+        for (uint8_t index = 0; index < boardCount; index++) {
+            flushBoard(&boards[index]);
+        }
+    }
+
+    //Disables the outputs whose timeout passed, then re-arms the timer for the earliest one left
+    void PCA9685PWM::timerExpired(droid::core::TimerId timer) {
+        std::lock_guard<std::mutex> guard(busLock);
+        uint32_t now = clock->millis();
+        bool anyTimed = false;
+        uint32_t nextDisableAt = 0;
+        for (uint8_t index = 0; index < boardCount; index++) {
+            Board* board = &boards[index];
+            uint16_t timed = board->timed;
+            for (uint8_t channel = 0; timed != 0; channel++, timed >>= 1) {
+                if ((timed & 1) == 0) {
+                    continue;
+                }
+                if ((int32_t) (now - board->disableAt[channel]) >= 0) {
+                    LOGGER_LOG(logger, logId, DEBUG, "disabling PWM output %d after timeout\n", index * PWM_OUTPUTS_PER_BOARD + channel);
+                    setPin(board, channel, 0);
+                } else if (!anyTimed || ((int32_t) (board->disableAt[channel] - nextDisableAt) < 0)) {
+                    nextDisableAt = board->disableAt[channel];
+                    anyTimed = true;
+                }
             }
         }
+        if (anyTimed) {
+            timers->start(disableTimer, nextDisableAt - now);
+        }
     }
 
     void PCA9685PWM::failsafe() {
-        if (!initialized) return;
-        for (int i = 0; i < NUMBER_OF_PWM_OUTPUTS; i++) {
-            pca9685Driver.setPin(i, 0);
-            outDetails[i].disableAt = 0;
-            outDetails[i].isActive = false;
+        for (uint8_t index = 0; index < boardCount; index++) {
+            Board* board = &boards[index];
+            if (!board->initialized) {
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> guard(busLock);
+                for (uint8_t channel = 0; channel < PWM_OUTPUTS_PER_BOARD; channel++) {
+                    setPin(board, channel, 0);
+                }
+            }
+            flushBoard(board);
         }
         if (outputEnablePin != 0) {
             digitalWrite(outputEnablePin, HIGH);
@@ -75,33 +134,29 @@ namespace droid::services {
     }
 
     void PCA9685PWM::setPWMuS(uint8_t outNum, uint16_t pulseMicroseconds, uint16_t durationMilliseconds) {
-        logger->log(name, DEBUG, "setPWMuS output %d, pulse: %d, duration: %d\n", outNum, pulseMicroseconds, durationMilliseconds);
-        if (!initialized) return;
-        if (outNum >= NUMBER_OF_PWM_OUTPUTS) {
+        LOGGER_LOG(logger, logId, DEBUG, "setPWMuS output %d, pulse: %d, duration: %d\n", outNum, pulseMicroseconds, durationMilliseconds);
+        Board* board = boardOf(outNum);
+        if (board == NULL) {
             return;
         }
-        logger->log(name, DEBUG, "getting ready to write to pca9685\n");
+        uint8_t channel = outNum % PWM_OUTPUTS_PER_BOARD;
+        std::lock_guard<std::mutex> guard(busLock);
         if (pulseMicroseconds == 0) {
-            pca9685Driver.setPin(outNum, 0);
-            outDetails[outNum].isActive = false;
-            outDetails[outNum].disableAt = 0;
+            setPin(board, channel, 0);
         } else {
-            logger->log(name, DEBUG, "oscFeq=%d, prescale=%d\n",pca9685Driver.getOscillatorFrequency(),pca9685Driver.readPrescale());
-            pca9685Driver.writeMicroseconds(outNum, pulseMicroseconds);
-            outDetails[outNum].isActive = true;
-            if (durationMilliseconds > 0) {
-                outDetails[outNum].disableAt = millis() + durationMilliseconds;
-            } else {
-                outDetails[outNum].disableAt = 0;
-            }
+            //Same conversion as Adafruit_PWMServoDriver::writeMicroseconds(), without reading the prescale back
+            uint64_t ticks = ((uint64_t) pulseMicroseconds * board->driver->getOscillatorFrequency()) / (1000000ULL * (board->prescale + 1));
+            setChannel(board, channel, 0, min(ticks, (uint64_t) 4095));
+            setTimeout(board, channel, durationMilliseconds);
         }
     }
 
     void PCA9685PWM::setPWMpercent(uint8_t outNum, uint8_t percent, uint16_t durationMilliseconds) {
-        if (!initialized) return;
-        if (outNum >= NUMBER_OF_PWM_OUTPUTS) {
+        Board* board = boardOf(outNum);
+        if (board == NULL) {
             return;
         }
+        uint8_t channel = outNum % PWM_OUTPUTS_PER_BOARD;
         if (percent > 100) {
             percent = 100;
         }
@@ -112,13 +167,107 @@ namespace droid::services {
         if (percent == 100) {
             onTicks = 4095;
         }
-//        logger->log(name, DEBUG, "setPWMpercent output %d, percent: %d, duration: %d\n", outNum, percent, durationMilliseconds);
-        pca9685Driver.setPin(outNum, onTicks);
-        outDetails[outNum].isActive = (onTicks > 0);
-        if ((durationMilliseconds > 0) && (onTicks > 0)) {
-            outDetails[outNum].disableAt = millis() + durationMilliseconds;
+//        LOGGER_LOG(logger, logId, DEBUG, "setPWMpercent output %d, percent: %d, duration: %d\n", outNum, percent, durationMilliseconds);
+        std::lock_guard<std::mutex> guard(busLock);
+        setPin(board, channel, onTicks);
+        if (onTicks > 0) {
+            setTimeout(board, channel, durationMilliseconds);
+        }
+    }
+
+    PCA9685PWM::Board* PCA9685PWM::boardOf(uint8_t outNum) {
+        uint8_t index = outNum / PWM_OUTPUTS_PER_BOARD;
+        if ((index >= boardCount) || !boards[index].initialized) {
+            return NULL;
+        }
+        return &boards[index];
+    }
+
+    //Register values of Adafruit_PWMServoDriver::setPin(), 4096 sets the full on/off bit.
+    //  Turning an output off also cancels its timeout.
+    void PCA9685PWM::setPin(Board* board, uint8_t channel, uint16_t onTicks) {
+        if (onTicks >= 4095) {
+            setChannel(board, channel, 4096, 0);
+        } else if (onTicks == 0) {
+            setChannel(board, channel, 0, 4096);
+            board->timed &= ~(1 << channel);
+        } else {
+            setChannel(board, channel, 0, onTicks);
+        }
+    }
+
+    void PCA9685PWM::setTimeout(Board* board, uint8_t channel, uint16_t durationMilliseconds) {
+        if (durationMilliseconds > 0) {
+            board->disableAt[channel] = clock->millis() + durationMilliseconds;
+            board->timed |= (1 << channel);
+            //The timer only ever needs to be moved earlier, later deadlines are picked up when it fires
+            if (!timers->isRunning(disableTimer) ||
+                ((int32_t) (board->disableAt[channel] - timers->getDueAt(disableTimer)) < 0)) {
+                timers->start(disableTimer, durationMilliseconds);
+            }
         } else {
-            outDetails[outNum].disableAt = 0;
+            board->timed &= ~(1 << channel);
+        }
+    }
+
+    void PCA9685PWM::setChannel(Board* board, uint8_t channel, uint16_t on, uint16_t off) {
+        board->pending[channel].on = on;
+        board->pending[channel].off = off;
+        if ((on != board->written[channel].on) || (off != board->written[channel].off)) {
+            board->dirty |= (1 << channel);
+        } else {
+            board->dirty &= ~(1 << channel);
+        }
+    }
+
+    //Each run of consecutive dirty outputs goes out as one auto-increment write, starting at
+    //  the LEDn_ON_L register of the first output of the run.  busLock is only held to copy the
+    //  registers in and out, never during the I2C writes.
+    void PCA9685PWM::flushBoard(Board* board) {
+        ChannelRegs regs[PWM_OUTPUTS_PER_BOARD];
+        uint16_t remaining;
+        {
+            std::lock_guard<std::mutex> guard(busLock);
+            remaining = board->dirty;
+            board->dirty = 0;
+            for (uint8_t channel = 0; channel < PWM_OUTPUTS_PER_BOARD; channel++) {
+                if ((remaining & (1 << channel)) != 0) {
+                    regs[channel] = board->pending[channel];
+                }
+            }
+        }
+        uint8_t channel = 0;
+        while (remaining != 0) {
+            while ((remaining & (1 << channel)) == 0) {
+                channel++;
+            }
+            uint8_t first = channel;
+            i2c->beginTransmission(board->address);
+            i2c->write(PCA9685_LED0_ON_L + (4 * first));
+            while ((channel < PWM_OUTPUTS_PER_BOARD) && ((remaining & (1 << channel)) != 0)) {
+                i2c->write(regs[channel].on & 0xFF);
+                i2c->write(regs[channel].on >> 8);
+                i2c->write(regs[channel].off & 0xFF);
+                i2c->write(regs[channel].off >> 8);
+                channel++;
+            }
+            uint16_t run = ((1 << channel) - 1) & ~((1 << first) - 1);
+            remaining &= ~run;
+            bool written = (i2c->endTransmission() == 0);
+            std::lock_guard<std::mutex> guard(busLock);
+            if (written) {
+                for (uint8_t index = first; index < channel; index++) {
+                    board->written[index] = regs[index];
+                    //Set again while the write was going out
+                    if ((board->pending[index].on != regs[index].on) || (board->pending[index].off != regs[index].off)) {
+                        board->dirty |= (1 << index);
+                    }
+                }
+            } else {
+                //Left dirty, retried by the next task()
+                board->dirty |= run;
+                LOGGER_LOG_LIMITED(logger, logId, WARN, LOGGER_LIMIT_TICK_MS, LOGGER_LIMIT_TICK_BURST, "I2C write of board 0x%02x outputs %d to %d failed\n", board->address, first, channel - 1);
+            }
         }
     }
-}
\ No newline at end of file
+}
@@ -15,6 +15,14 @@
 
 #define LOGNAME "Main"
 
+#ifdef MECHMIND_NATIVE
+//Provided by native/src/main.cpp, a VirtualClock when simulating or nullptr for real time
+extern Clock* nativeClock;
+#define SYSTEM_CLOCK nativeClock
+#else
+#define SYSTEM_CLOCK nullptr
+#endif
+
 droid::core::System* sys;
 droid::brain::Brain* brain;
 BufferedStream* bufferedStream;
@@ -32,25 +40,30 @@ void setup() {
     
     delay(500);
 
-    bufferedStream = new BufferedStream(LOGGER_STREAM, 10240);
-    sys = new droid::core::System(LOGGER_STREAM, DEBUG);
+    bufferedStream = new BufferedStream(LOGGER_STREAM, LOGGER_STREAM_BUFFER_SIZE, LOGGER_STREAM_OVERFLOW);
+    sys = new droid::core::System(bufferedStream, DEBUG, SYSTEM_CLOCK);
     brain = new droid::brain::Brain("R2D2", sys);
 
     brain->init();
     brain->logConfig();
     
     sys->getLogger()->log(LOGNAME, INFO, "Free Memory: %d\n", ESP.getFreeHeap());
+
+    //Logged synchronously until here, the burst of startup messages would overflow the deferred records
+    sys->getLogger()->start(LOGGER_TASK_CORE, LOGGER_TASK_PRIORITY, LOGGER_TASK_STACK_SIZE);
+    brain->start();
 }
 
 #define ONE_MINUTE 60000
-ulong next = millis() + ONE_MINUTE;
+ulong next = ONE_MINUTE;
 
 void loop() {
     brain->task();
     bufferedStream->task();
 
-    if (millis() >= next) {
-        sys->getLogger()->log(LOGNAME, INFO, "Free Memory: %d\n", ESP.getFreeHeap());
+    if (sys->getClock()->millis() >= next) {
+        sys->getLogger()->log(LOGNAME, INFO, "Free Memory: %d, log bytes dropped: %lu, log buffer high water: %u\n",
+            ESP.getFreeHeap(), bufferedStream->getDroppedBytes(), (unsigned int) bufferedStream->getHighWater());
         next = next + ONE_MINUTE;
     }
 }
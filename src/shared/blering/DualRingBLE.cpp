@@ -50,7 +50,7 @@ namespace blering {
     private:
         void onConnect(NimBLEClient* pClient) {
             const char* peerAddress = pClient->getPeerAddress().toString().c_str();
-            logger->log(name, INFO, "Connected to: %s\r\n", peerAddress);
+            LOGGER_LOG(logger, name, INFO, "Connected to: %s\r\n", peerAddress);
             pClient->updateConnParams(120,120,0,60);
             Ring* driveRing = rings.getRing(DualRingBLE::Drive);
             Ring* domeRing = rings.getRing(DualRingBLE::Dome);
@@ -64,7 +64,7 @@ namespace blering {
 
         void onDisconnect(NimBLEClient* pClient) {
             const char* peerAddress = pClient->getPeerAddress().toString().c_str();
-            logger->log(name, INFO, "%s Disconnected\n", peerAddress);
+            LOGGER_LOG(logger, name, INFO, "%s Disconnected\n", peerAddress);
             Ring* driveRing = rings.getRing(DualRingBLE::Drive);
             Ring* domeRing = rings.getRing(DualRingBLE::Dome);
             if (!strncmp(domeRing->address, peerAddress, sizeof(domeRing->address))) {
@@ -76,7 +76,7 @@ namespace blering {
                 driveRing->waitingFor = true;
             }
             if (!NimBLEDevice::getScan()->isScanning()) {
-                logger->log(name, INFO, "Restarting scan");
+                LOGGER_LOG(logger, name, INFO, "Restarting scan");
                 NimBLEDevice::getScan()->start(scanTime, scanEndedCB);
             }
         };
@@ -123,62 +123,62 @@ namespace blering {
             if ((advType == BLE_HCI_ADV_TYPE_ADV_DIRECT_IND_HD) ||
                 (advType == BLE_HCI_ADV_TYPE_ADV_DIRECT_IND_LD) ||
                 (advertisedDevice->haveServiceUUID() && advertisedDevice->isAdvertisingService(NimBLEUUID(HID_SERVICE)))) {
-                logger->log(name, DEBUG, "Advertised HID Device found: %s\n", advertisedDevice->toString().c_str());
-                logger->log(name, DEBUG, "Name = %s\n", advertisedDevice->getName().c_str());
+                LOGGER_LOG(logger, name, DEBUG, "Advertised HID Device found: %s\n", advertisedDevice->toString().c_str());
+                LOGGER_LOG(logger, name, DEBUG, "Name = %s\n", advertisedDevice->getName().c_str());
 
                 Ring* driveRing = rings.getRing(DualRingBLE::Drive);
                 Ring* domeRing = rings.getRing(DualRingBLE::Dome);
 
                 if (strstr(advertisedDevice->getName().c_str(), "Magicsee R1") != NULL) {
                     const char* peerAddress = advertisedDevice->getAddress().toString().c_str();
-                    logger->log(name, INFO, "Found matching device with address: %s\n", peerAddress);
+                    LOGGER_LOG(logger, name, INFO, "Found matching device with address: %s\n", peerAddress);
 
                     if (!strncmp(DriveMAC, advertisedDevice->getAddress().toString().c_str(), sizeof(DriveMAC))) {
                         //Found Drive Ring by saved MAC
                         if (driveRing->waitingFor) {
-                            logger->log(name, INFO, "Reassigning to Drive\n");
+                            LOGGER_LOG(logger, name, INFO, "Reassigning to Drive\n");
                             driveRing->waitingFor = false;
                             driveRing->advertisedDevice = advertisedDevice;
                             driveRing->connectTo = true;
                         } else {
-                            logger->log(name, INFO, "Drive Ring already assigned!\n");
+                            LOGGER_LOG(logger, name, INFO, "Drive Ring already assigned!\n");
                         }
                     } else if (!strncmp(DomeMAC, advertisedDevice->getAddress().toString().c_str(), sizeof(DomeMAC))) {
                         //Found Dome Ring by saved MAC
                         if (domeRing->waitingFor) {
-                            logger->log(name, INFO, "Reassigning to Dome\n");
+                            LOGGER_LOG(logger, name, INFO, "Reassigning to Dome\n");
                             domeRing->waitingFor = false;
                             domeRing->advertisedDevice = advertisedDevice;
                             domeRing->connectTo = true;
                         } else {
-                            logger->log(name, INFO, "Dome Ring already assigned!\n");
+                            LOGGER_LOG(logger, name, INFO, "Dome Ring already assigned!\n");
                         }
                     } else {
                         //We have an unknown Ring
                         if ((driveRing->waitingFor) &&
                             (DriveMAC[0] == 'X')) {
                             //Unrecognized Ring and Drive Ring doesn't have an assigned address yet
-                            logger->log(name, INFO, "Assigning to Drive\n");
+                            LOGGER_LOG(logger, name, INFO, "Assigning to Drive\n");
                             driveRing->waitingFor = false;
                             driveRing->advertisedDevice = advertisedDevice;
                             driveRing->connectTo = true;
                         } else if ((domeRing->waitingFor) &&
                                 (DomeMAC[0] == 'X')) {
                             //Unrecognized Ring and Dome Ring doesn't have an assigned address yet
-                            logger->log(name, INFO, "Assigning to Dome\n");
+                            LOGGER_LOG(logger, name, INFO, "Assigning to Dome\n");
                             domeRing->waitingFor = false;
                             domeRing->advertisedDevice = advertisedDevice;
                             domeRing->connectTo = true;
                         } else {
-                            logger->log(name, INFO, "Neither ring claimed the connection\n");
+                            LOGGER_LOG(logger, name, INFO, "Neither ring claimed the connection\n");
                         }
                     }
                 } else {
-                    logger->log(name, INFO, "Not a Match.  Device name: s\n", advertisedDevice->getName().c_str());
+                    LOGGER_LOG(logger, name, INFO, "Not a Match.  Device name: s\n", advertisedDevice->getName().c_str());
                 }
                 if ((!driveRing->waitingFor && !domeRing->waitingFor) && 
                     NimBLEDevice::getScan()->isScanning()) {
-                    logger->log(name, DEBUG, "Stopping Scan in AdvDeviceCallback driveWait=%d, domeWait=%d\n", driveRing->waitingFor, domeRing->waitingFor);
+                    LOGGER_LOG(logger, name, DEBUG, "Stopping Scan in AdvDeviceCallback driveWait=%d, domeWait=%d\n", driveRing->waitingFor, domeRing->waitingFor);
                     NimBLEDevice::getScan()->stop();
                 }
             }
@@ -302,14 +302,15 @@ namespace blering {
         config->clear(name);
     }
 
+    //Formatted here, the text then goes to the Logger as a %s argument (copied into the record)
     void DualRingBLE::log(LogLevel level, const char *format, ...) {
-        char buf[100];
+        char buf[LOGGER_RECORD_TEXT_LEN];
         if (logger) {
             va_list args; 
             va_start(args, format); 
             vsnprintf(buf, sizeof(buf), format, args);
             va_end(args);
-            logger->log(name, level, buf);
+            logger->log(name, level, "%s", buf);
         }
     }
 
@@ -324,10 +325,10 @@ namespace blering {
         driveRing.setOtherRing(&domeRing);
         domeRing.setOtherRing(&driveRing);
 
-        logger->log(name, DEBUG, "Before loading Prefs, Drive: %s, Dome: %s\n", DriveMAC, DomeMAC);
+        LOGGER_LOG(logger, name, DEBUG, "Before loading Prefs, Drive: %s, Dome: %s\n", DriveMAC, DomeMAC);
         strncpy(DriveMAC, config->getString(name, CONFIG_KEY_BLERING_DRIVEMAC, CONFIG_DEFAULT_BLERING_DRIVEMAC).c_str(), sizeof(DriveMAC));
         strncpy(DomeMAC, config->getString(name, CONFIG_KEY_BLERING_DOMEMAC, CONFIG_DEFAULT_BLERING_DOMEMAC).c_str(), sizeof(DomeMAC));
-        logger->log(name, DEBUG, "After  loading Prefs, Drive: %s, Dome: %s\n", DriveMAC, DomeMAC);
+        LOGGER_LOG(logger, name, DEBUG, "After  loading Prefs, Drive: %s, Dome: %s\n", DriveMAC, DomeMAC);
 
         NimBLEDevice::init(name);
         //Begin listening for advertisements
@@ -338,12 +339,12 @@ namespace blering {
 
         if ((DriveMAC[0] != 'X') &&
             (DomeMAC[0] != 'X')) {      //We have two MACs, enabled whitelist for scan
-            logger->log(name, DEBUG, "Two MACs defined, enabling scan whitelist; drive: %s, dome: %s\n", DriveMAC, DomeMAC);
+            LOGGER_LOG(logger, name, DEBUG, "Two MACs defined, enabling scan whitelist; drive: %s, dome: %s\n", DriveMAC, DomeMAC);
             NimBLEDevice::whiteListAdd(NimBLEAddress(DriveMAC));
             NimBLEDevice::whiteListAdd(NimBLEAddress(DomeMAC));
             pScan->setFilterPolicy(BLE_HCI_SCAN_FILT_USE_WL);
         } else {
-            logger->log(name, DEBUG, "Not enabling scan whitelist; drive: %s, dome: %s\n", DriveMAC, DomeMAC);
+            LOGGER_LOG(logger, name, DEBUG, "Not enabling scan whitelist; drive: %s, dome: %s\n", DriveMAC, DomeMAC);
         }
         
         /** create a callback that gets called when advertisers are found */
@@ -355,7 +356,7 @@ namespace blering {
 
         pScan->setActiveScan(false);
 
-        logger->log(name, DEBUG, "Scanning\n");
+        LOGGER_LOG(logger, name, DEBUG, "Scanning\n");
         pScan->start(scanTime, scanEndedCB);
     }
 
@@ -366,8 +367,8 @@ namespace blering {
     }
 
     void DualRingBLE::logConfig() {
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BLERING_DRIVEMAC, config->getString(name, CONFIG_KEY_BLERING_DRIVEMAC, "").c_str());
-        logger->log(name, INFO, "Config %s = %s\n", CONFIG_KEY_BLERING_DOMEMAC, config->getString(name, CONFIG_KEY_BLERING_DOMEMAC, "").c_str());
+        LOGGER_LOG(logger, name, INFO, "Config %s = %s\n", CONFIG_KEY_BLERING_DRIVEMAC, config->getString(name, CONFIG_KEY_BLERING_DRIVEMAC, "").c_str());
+        LOGGER_LOG(logger, name, INFO, "Config %s = %s\n", CONFIG_KEY_BLERING_DOMEMAC, config->getString(name, CONFIG_KEY_BLERING_DOMEMAC, "").c_str());
     }
 
     void DualRingBLE::task() {
@@ -456,9 +457,9 @@ namespace blering {
     }
 
     void DualRingBLE::printState() {
-        logger->log(name, DEBUG, "Drive: ");
+        LOGGER_LOG(logger, name, DEBUG, "Drive: ");
         driveRing.printState();
-        logger->log(name, DEBUG, "Dome:  ");
+        LOGGER_LOG(logger, name, DEBUG, "Dome:  ");
         domeRing.printState();
     }
 }
\ No newline at end of file
@@ -374,17 +374,17 @@ namespace blering {
     }
 
     void MagicseeR1::printState() {
-        logger->log(name, DEBUG, "Ring state: MODE-%s : ", modeString(getMode()));
-        if (isButtonPressed(MagicseeR1::A)) logger->printf(name, DEBUG, "A."); else logger->printf(name, DEBUG, " .");
-        if (isButtonPressed(MagicseeR1::B)) logger->printf(name, DEBUG, "B."); else logger->printf(name, DEBUG, " .");
-        if (isButtonPressed(MagicseeR1::C)) logger->printf(name, DEBUG, "C."); else logger->printf(name, DEBUG, " .");
-        if (isButtonPressed(MagicseeR1::D)) logger->printf(name, DEBUG, "D."); else logger->printf(name, DEBUG, " .");
-        if (isButtonPressed(MagicseeR1::L1)) logger->printf(name, DEBUG, "L1."); else logger->printf(name, DEBUG, "  .");
-        if (isButtonPressed(MagicseeR1::L2)) logger->printf(name, DEBUG, "L2."); else logger->printf(name, DEBUG, "  .");
-        if (isButtonPressed(MagicseeR1::UP)) logger->printf(name, DEBUG, "UP."); else logger->printf(name, DEBUG, "  .");
-        if (isButtonPressed(MagicseeR1::DOWN)) logger->printf(name, DEBUG, "DOWN."); else logger->printf(name, DEBUG, "    .");
-        if (isButtonPressed(MagicseeR1::LEFT)) logger->printf(name, DEBUG, "LEFT."); else logger->printf(name, DEBUG, "    .");
-        if (isButtonPressed(MagicseeR1::RIGHT)) logger->printf(name, DEBUG, "RIGHT"); else logger->printf(name, DEBUG, "     ");
-        logger->printf(name, DEBUG, "\n");
+        LOGGER_LOG(logger, name, DEBUG, "Ring state: MODE-%s : ", modeString(getMode()));
+        if (isButtonPressed(MagicseeR1::A)) LOGGER_PRINTF(logger, name, DEBUG, "A."); else LOGGER_PRINTF(logger, name, DEBUG, " .");
+        if (isButtonPressed(MagicseeR1::B)) LOGGER_PRINTF(logger, name, DEBUG, "B."); else LOGGER_PRINTF(logger, name, DEBUG, " .");
+        if (isButtonPressed(MagicseeR1::C)) LOGGER_PRINTF(logger, name, DEBUG, "C."); else LOGGER_PRINTF(logger, name, DEBUG, " .");
+        if (isButtonPressed(MagicseeR1::D)) LOGGER_PRINTF(logger, name, DEBUG, "D."); else LOGGER_PRINTF(logger, name, DEBUG, " .");
+        if (isButtonPressed(MagicseeR1::L1)) LOGGER_PRINTF(logger, name, DEBUG, "L1."); else LOGGER_PRINTF(logger, name, DEBUG, "  .");
+        if (isButtonPressed(MagicseeR1::L2)) LOGGER_PRINTF(logger, name, DEBUG, "L2."); else LOGGER_PRINTF(logger, name, DEBUG, "  .");
+        if (isButtonPressed(MagicseeR1::UP)) LOGGER_PRINTF(logger, name, DEBUG, "UP."); else LOGGER_PRINTF(logger, name, DEBUG, "  .");
+        if (isButtonPressed(MagicseeR1::DOWN)) LOGGER_PRINTF(logger, name, DEBUG, "DOWN."); else LOGGER_PRINTF(logger, name, DEBUG, "    .");
+        if (isButtonPressed(MagicseeR1::LEFT)) LOGGER_PRINTF(logger, name, DEBUG, "LEFT."); else LOGGER_PRINTF(logger, name, DEBUG, "    .");
+        if (isButtonPressed(MagicseeR1::RIGHT)) LOGGER_PRINTF(logger, name, DEBUG, "RIGHT"); else LOGGER_PRINTF(logger, name, DEBUG, "     ");
+        LOGGER_PRINTF(logger, name, DEBUG, "\n");
     }
 }
\ No newline at end of file
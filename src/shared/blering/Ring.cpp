@@ -8,18 +8,19 @@
  * For more information, visit https://github.com/kizmit99/MechMind
  */
 
+#define LOGGER_FLOOR LOGGER_FLOOR_RING
 #include "shared/blering/Ring.h"
 #include "shared/blering/MagicseeR1.h"
 #include "shared/blering/ReportQueue.h"
 
 namespace blering {
     void Ring::onConnect() {
-        logger->log(name, DEBUG, "Ring.onConnect: %s\n", address);
+        LOGGER_LOG(logger, name, DEBUG, "Ring.onConnect: %s\n", address);
         connected = true;
     }
 
     void Ring::onDisconnect() {
-        logger->log(name, DEBUG, "Ring.onDisconnect: %s\n", address);
+        LOGGER_LOG(logger, name, DEBUG, "Ring.onDisconnect: %s\n", address);
         myRing.disconnect();
         waitingFor = true;
         connectTo = false;
@@ -55,11 +56,13 @@ namespace blering {
         if (!reportQueue.isEmpty()) {
             ReportRecord *newReport = reportQueue.getNextReport();
 
-            logger->log(name, DEBUG, "%s:", __func__);
-            for (size_t i = 0; i < newReport->report_len; i++) {
-                logger->printf(name, DEBUG, " %02x", newReport->report[i]);
+            if (LOGGER_ENABLED(logger, name, DEBUG)) {
+                LOGGER_LOG(logger, name, DEBUG, "%s:", __func__);
+                for (size_t i = 0; i < newReport->report_len; i++) {
+                    LOGGER_PRINTF(logger, name, DEBUG, " %02x", newReport->report[i]);
+                }
+                LOGGER_PRINTF(logger, name, DEBUG, "\n");
             }
-            logger->printf(name, DEBUG, "\n");
 
             bool l2Before = myRing.isButtonPressed(MagicseeR1::L2);
             myRing.handleReport(newReport->report, newReport->report_len);
@@ -147,7 +150,7 @@ namespace blering {
             default:
                 value = 0;
         }
-        if (value != 0) {
+        if ((value != 0) && LOGGER_ADMIT(logger, name, DEBUG, stateLimit)) {
             printState();
         }
         return value;